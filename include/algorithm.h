@@ -1,10 +1,12 @@
 #ifndef ALGORITHM_H
 #define ALGORITHM_H
 
+#include <atomic>
 #include <vector>
 #include <functional>
 #include <random>
 #include "order.h"
+#include "setup_times.h"
 #include "schedule_data.h"
 
 // Constants
@@ -12,29 +14,54 @@ constexpr double IMPROVEMENT_THRESHOLD = 1.0;
 constexpr int MAX_NO_IMPROVEMENT_ITERATIONS = 240;
 void printImprovementStatistics();
 constexpr int GRASP_ITERATIONS = 10;
-constexpr int RCL_SIZE = 15;
+// Reactive GRASP: candidate RCL sizes, iterations between probability updates and
+// the exponent that sharpens the preference for alphas with low average penalties
+constexpr double GRASP_REACTIVE_ALPHAS[] = {0.05, 0.15, 0.25, 0.4};
+constexpr int GRASP_REACTIVE_PERIOD = 3;
+constexpr double GRASP_REACTIVE_EXPONENT = 10.0;
+// Constructions whose ILS produced the best results, used as the dominance threshold
+constexpr int GRASP_ELITE_SIZE = 3;
 constexpr int TABU_TENURE = 100;
 constexpr int MAX_TABU_LIST_SIZE = 1000;
 
 // algorithm.h
-extern int swap_improvement_count;
-extern int block_exchange_improvement_count;
-extern int two_opt_improvement_count;
-extern int block_shift_improvement_count;
+extern std::atomic<int> swap_improvement_count;
+extern std::atomic<int> block_exchange_improvement_count;
+extern std::atomic<int> two_opt_improvement_count;
+extern std::atomic<int> block_shift_improvement_count;
+extern std::atomic<int> or_opt_improvement_count;
 
 size_t computeScheduleHash(const std::vector<int>& schedule);
 
 
 double calculateTotalPenaltyForSchedule(const std::vector<int>& schedule,
                                  const std::vector<Order>& orders,
-                                 const std::vector<std::vector<int>>& setupTimes,
+                                 const SetupTimes& setupTimes,
                                  const std::vector<int>& initialSetupTimes);
 
+// Called with the new best penalty whenever the search improves its incumbent
+using ImprovementCallback = std::function<void(double penalty)>;
+
+struct GraspConfig {
+    double lowerBound = 0.0;    // Proven lower bound on the optimal penalty (see lower_bound.h)
+    double gapTolerance = 0.0;  // Stop once the incumbent is within this relative gap of lowerBound
+    bool reactive = false;      // Pick alpha from GRASP_REACTIVE_ALPHAS by past results; fixedAlpha otherwise
+    double fixedAlpha = 0.25;
+    bool skipDominated = false; // Skip ILS on constructions clearly worse than the elite ones
+    double dominanceMargin = 0.1;  // Relative margin above the elite threshold before a construction is skipped
+    ImprovementCallback onImprovement;  // Optional trace of every new GRASP incumbent (see bench.cpp)
+    int ilsThreads = 1;         // Perturbations ILS evaluates concurrently per iteration; 1 = sequential
+};
+
+// Penalty at or below which the search may stop, given a lower bound and a relative gap
+double targetPenalty(const GraspConfig& config);
+
 std::vector<int> GRASP(const std::vector<Order>& orders,
-                       const std::vector<std::vector<int>>& setupTimes,
+                       const SetupTimes& setupTimes,
                        const std::vector<int>& initialSetupTimes,
                        double& totalPenaltyCost,
-                       std::mt19937& rng);
+                       std::mt19937& rng,
+                       const GraspConfig& config = GraspConfig());
 
 struct pair_hash
 {
@@ -63,25 +90,32 @@ struct ComparePriority {
 double calculatePriority(const Order &order, int setupTime);
 
 
-void calculateTotalPenalty(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                           const std::vector<std::vector<int>> &setupTimes,
+// The local search is instantiated for every schedule representation in compact_schedule.h
+template <typename Schedule>
+void calculateTotalPenalty(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                           const SetupTimes &setupTimes,
                            const std::vector<int> &initialSetupTimes);
 
-void RVND(ScheduleData& scheduleData, const std::vector<Order>& orders,
-                  const std::vector<std::vector<int>>& setupTimes,
+template <typename Schedule>
+void RVND(BasicScheduleData<Schedule>& scheduleData, const std::vector<Order>& orders,
+                  const SetupTimes& setupTimes,
                   const std::vector<int>& initialSetupTimes, std::mt19937& rng);
 
-void perturbSolution(std::vector<int>& schedule, std::mt19937& rng);
+template <typename Schedule>
+void perturbSolution(Schedule& schedule, std::mt19937& rng);
 
 std::vector<int> ILS(const std::vector<int>& initialSchedule,
                      const std::vector<Order>& orders,
-                     const std::vector<std::vector<int>>& setupTimes,
+                     const SetupTimes& setupTimes,
                      const std::vector<int>& initialSetupTimes,
                      double& currentPenaltyCost,
-                     std::mt19937& rng);
+                     std::mt19937& rng,
+                     double targetPenalty = 0.0,
+                     const ImprovementCallback& onImprovement = nullptr,
+                     int speculativeThreads = 1);
 
 std::vector<int> greedyConstruction(const std::vector<Order> &orders,
-                                    const std::vector<std::vector<int>> &setupTimes,
+                                    const SetupTimes &setupTimes,
                                     const std::vector<int> &initialSetupTimes,
                                     double alpha,
                                     std::mt19937* rng);
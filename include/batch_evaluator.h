@@ -0,0 +1,116 @@
+// batch_evaluator.h
+#ifndef BATCH_EVALUATOR_H
+#define BATCH_EVALUATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+
+// Widest batch supported (AVX-512 lanes of 32-bit job ids)
+constexpr int BATCH_MAX_LANES = 16;
+
+// Flattened, 32-bit view of the instance read by the batch kernels
+struct BatchInstanceView {
+    const std::int32_t* setups;      // (F + 1) x F row-major; row F holds the initial setups
+    const std::int32_t* families;    // Setup row/column of each job; unused by the dense kernels (F = n)
+    const std::int32_t* processing;
+    const std::int32_t* due;
+    const double* weights;
+    int numFamilies;                 // F
+};
+
+// Evaluates `lanes` candidates stored position-major (jobs[position * lanes + lane])
+// from position 0 to `length`, starting at startTime after the setup row previousRow (F = none)
+using BatchKernel = void (*)(const BatchInstanceView& view, const std::int32_t* jobs, int length,
+                             std::int32_t startTime, std::int32_t previousRow, double* penalties);
+
+/**
+ * Scores many candidate schedules at once. Candidates sharing a common prefix are
+ * laid out in structure-of-arrays form and advanced in lockstep with AVX2 (8 lanes)
+ * or AVX-512 (16 lanes) gathers from the setup matrix, accumulating max(0, C - d) * w
+ * per lane. Family-clustered instances gather from the F x F family matrix through
+ * one more gather of each job's family. The instruction set is chosen at runtime; without a vector unit the
+ * evaluator reports itself as disabled and callers keep the scalar path.
+ */
+class BatchEvaluator {
+public:
+    BatchEvaluator();
+
+    /**
+     * Flattens the instance. This copies the whole setup table, so it is skipped
+     * when the instance is the one already loaded: same setup table identity and
+     * same order and initial setup vectors.
+     */
+    void load(const std::vector<Order>& orders,
+              const SetupTimes& setupTimes,
+              const std::vector<int>& initialSetupTimes);
+
+    // True when a vector kernel is available and the instance fits in 32-bit lanes
+    // (and, for clustered setups, the initial setups depend only on the family)
+    bool enabled() const { return kernel != nullptr && fitsInLanes; }
+    int lanes() const { return laneCount; }
+
+    // Name of the instruction set selected at runtime ("avx512", "avx2" or "scalar")
+    static const char* instructionSet();
+
+    /**
+     * Starts a batch in which every lane equals `base`; only positions from
+     * `start` on are stored and evaluated.
+     */
+    template <typename Schedule>
+    void beginBatch(const Schedule& base, int start, long long startTime)
+    {
+        batchStart = start;
+        batchStartTime = startTime;
+        previousTask = start > 0 ? static_cast<int>(base[start - 1]) : n;
+        const int length = n - start;
+        jobs.resize(static_cast<std::size_t>(length) * laneCount);
+        for (int position = 0; position < length; ++position)
+        {
+            const std::int32_t job = base[start + position];
+            std::int32_t* row = jobs.data() + static_cast<std::size_t>(position) * laneCount;
+            for (int lane = 0; lane < laneCount; ++lane) row[lane] = job;
+        }
+    }
+
+    void setJob(int position, int lane, int job)
+    {
+        jobs[static_cast<std::size_t>(position - batchStart) * laneCount + lane] = job;
+    }
+
+    /**
+     * Writes, for each lane, the penalty of positions [start, n) of its candidate.
+     */
+    void evaluate(double* penalties) const;
+
+private:
+    BatchKernel kernel;
+    BatchKernel denseKernel;
+    BatchKernel clusteredKernel;
+    int laneCount;
+    int n = 0;
+    int numFamilies = 0;
+    bool fitsInLanes = false;
+
+    // Instance currently flattened, see load()
+    std::pair<std::uint64_t, std::uint64_t> loadedSetups{0, 0};
+    const Order* loadedOrders = nullptr;
+    const int* loadedInitialSetups = nullptr;
+    int loadedCount = -1;
+
+    std::vector<std::int32_t> setups;
+    std::vector<std::int32_t> families;
+    std::vector<std::int32_t> processing;
+    std::vector<std::int32_t> due;
+    std::vector<double> weights;
+
+    std::vector<std::int32_t> jobs;
+    int batchStart = 0;
+    long long batchStartTime = 0;
+    int previousTask = 0;
+};
+
+#endif // BATCH_EVALUATOR_H
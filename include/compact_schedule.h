@@ -0,0 +1,102 @@
+// compact_schedule.h
+#ifndef COMPACT_SCHEDULE_H
+#define COMPACT_SCHEDULE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Schedule stored inline in a fixed-capacity array of narrow job ids, so that
+ * copying it is a single memcpy of Capacity * sizeof(JobId) bytes instead of a
+ * heap allocation. It offers the subset of the std::vector interface used by
+ * the local search (size, indexing and random-access iterators).
+ */
+template <std::size_t Capacity, typename JobId>
+class CompactSchedule {
+    static_assert(Capacity - 1 <= std::numeric_limits<JobId>::max(), "Job ids must fit in JobId");
+
+    // Narrowest unsigned type that can hold the length, so it adds as little as possible to the array
+    using Length = std::conditional_t<Capacity <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+                   std::conditional_t<Capacity <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+                                      std::uint32_t>>;
+
+public:
+    using value_type = JobId;
+    using iterator = JobId*;
+    using const_iterator = const JobId*;
+
+    CompactSchedule() = default;
+
+    explicit CompactSchedule(const std::vector<int>& schedule)
+        : length(static_cast<Length>(schedule.size()))
+    {
+        for (std::size_t k = 0; k < schedule.size(); ++k)
+        {
+            jobs[k] = static_cast<JobId>(schedule[k]);
+        }
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+    std::size_t size() const { return length; }
+
+    JobId& operator[](std::size_t index) { return jobs[index]; }
+    const JobId& operator[](std::size_t index) const { return jobs[index]; }
+
+    iterator begin() { return jobs.data(); }
+    iterator end() { return jobs.data() + length; }
+    const_iterator begin() const { return jobs.data(); }
+    const_iterator end() const { return jobs.data() + length; }
+
+private:
+    std::array<JobId, Capacity> jobs{};
+    Length length = 0;
+};
+
+// Representations the solver is compiled for, from the narrowest to the widest.
+// TinySchedule only exists for the n = 60 benchmark set (and rolling-horizon windows of up
+// to 60 positions); RVND on n60A runs no faster with it than with SmallSchedule or std::vector.
+using TinySchedule = CompactSchedule<60, std::uint8_t>;      // 61 bytes, fits a cache line
+using SmallSchedule = CompactSchedule<256, std::uint8_t>;
+using MediumSchedule = CompactSchedule<1024, std::uint16_t>;
+
+static_assert(sizeof(TinySchedule) <= 64, "TinySchedule must fit in one cache line");
+
+// Expands INSTANTIATE(type) for every schedule representation, for explicit template instantiation
+#define FOR_EACH_SCHEDULE_TYPE(INSTANTIATE) \
+    INSTANTIATE(std::vector<int>)           \
+    INSTANTIATE(TinySchedule)               \
+    INSTANTIATE(SmallSchedule)              \
+    INSTANTIATE(MediumSchedule)
+
+template <typename Schedule>
+struct ScheduleTag {
+    using type = Schedule;
+};
+
+/**
+ * Calls visitor(ScheduleTag<Schedule>{}) with the narrowest representation that
+ * can hold numOrders jobs, falling back to std::vector<int> for larger instances.
+ */
+template <typename Visitor>
+decltype(auto) visitScheduleType(std::size_t numOrders, Visitor&& visitor)
+{
+    if (numOrders <= TinySchedule::capacity())
+    {
+        return visitor(ScheduleTag<TinySchedule>{});
+    }
+    if (numOrders <= SmallSchedule::capacity())
+    {
+        return visitor(ScheduleTag<SmallSchedule>{});
+    }
+    if (numOrders <= MediumSchedule::capacity())
+    {
+        return visitor(ScheduleTag<MediumSchedule>{});
+    }
+    return visitor(ScheduleTag<std::vector<int>>{});
+}
+
+#endif // COMPACT_SCHEDULE_H
@@ -0,0 +1,55 @@
+#ifndef EXACT_SOLVER_H
+#define EXACT_SOLVER_H
+
+#include <cstddef>
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+
+class NumaContext;
+
+// Instances up to this size are solved with the bitmask dynamic program,
+// larger ones fall back to branch-and-bound.
+constexpr int EXACT_DP_MAX_ORDERS = 22;
+constexpr double EXACT_TIME_LIMIT_SECONDS = 60.0;
+// Subtrees are handed to the worker threads from this depth of the search tree
+constexpr int EXACT_PARALLEL_SPLIT_DEPTH = 2;
+// Maximum number of (set, last job) labels kept per worker for dominance checks
+constexpr size_t EXACT_MEMO_MAX_ENTRIES = 1 << 20;
+
+struct ExactResult {
+    std::vector<int> schedule;   // Best schedule found (the incumbent if nothing better exists)
+    double penalty;              // Penalty of that schedule
+    double lowerBound;           // Proven lower bound on the optimal penalty
+    bool provenOptimal;          // True when the search space was exhausted
+    long long nodesExplored;     // DP labels or B&B nodes created
+};
+
+/**
+ * Solves the instance exactly, picking the bitmask DP for small instances and
+ * branch-and-bound otherwise. The incumbent (e.g. the GRASP result) is used as
+ * the initial upper bound; pass an empty schedule when none is available.
+ */
+ExactResult solveExact(const std::vector<Order>& orders,
+                       const SetupTimes& setupTimes,
+                       const std::vector<int>& initialSetupTimes,
+                       const std::vector<int>& incumbentSchedule,
+                       double timeLimitSeconds = EXACT_TIME_LIMIT_SECONDS,
+                       int numThreads = 0,
+                       const NumaContext* numa = nullptr);
+
+ExactResult dynamicProgrammingSolve(const std::vector<Order>& orders,
+                                    const SetupTimes& setupTimes,
+                                    const std::vector<int>& initialSetupTimes,
+                                    const std::vector<int>& incumbentSchedule,
+                                    double timeLimitSeconds);
+
+ExactResult branchAndBoundSolve(const std::vector<Order>& orders,
+                                const SetupTimes& setupTimes,
+                                const std::vector<int>& initialSetupTimes,
+                                const std::vector<int>& incumbentSchedule,
+                                double timeLimitSeconds,
+                                int numThreads,
+                                const NumaContext* numa = nullptr);
+
+#endif // EXACT_SOLVER_H
@@ -0,0 +1,123 @@
+// island.h
+#ifndef ISLAND_H
+#define ISLAND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "algorithm.h"
+#include "order.h"
+#include "setup_times.h"
+
+constexpr const char* ISLAND_DEFAULT_BOARD = "/juice_elite";
+// Attempts to read a slot whose owner is mid-write before giving up on it (e.g. the owner died)
+constexpr int ELITE_BOARD_READ_RETRIES = 10000;
+// ILS runs an island performs between two exchanges with the elite board
+constexpr int ISLAND_MIGRATION_INTERVAL = 2;
+constexpr int ISLAND_EPOCHS = 5;
+// RCL sizes cycled over the islands so that they construct from different regions
+constexpr double ISLAND_ALPHAS[] = {0.1, 0.25, 0.4, 0.55};
+
+enum class MigrationTopology {
+    Ring,      // Pull from the previous island only
+    Complete,  // Pull the best schedule published by any island
+    Random     // Pull from one island chosen at random each epoch
+};
+
+// Parses "ring", "complete" or "random"; throws std::invalid_argument otherwise
+MigrationTopology parseMigrationTopology(const std::string& name);
+const char* migrationTopologyName(MigrationTopology topology);
+
+struct IslandConfig {
+    std::string boardName = ISLAND_DEFAULT_BOARD;  // shm_open name, shared by all islands of a run
+    int islandId = 0;
+    int numIslands = 1;
+    int migrationInterval = ISLAND_MIGRATION_INTERVAL;
+    int epochs = ISLAND_EPOCHS;
+    MigrationTopology topology = MigrationTopology::Ring;
+    double alpha = -1.0;  // RCL size for the constructions; negative picks ISLAND_ALPHAS by island id
+};
+
+struct IslandResult {
+    std::vector<int> schedule;  // Best schedule found or adopted by this island
+    double penalty;
+    double boardBestPenalty;    // Best penalty on the elite board when the island finished
+    int boardBestIsland;
+    int immigrantsAdopted;      // Foreign schedules that replaced the island's incumbent
+};
+
+/**
+ * Elite board shared by the islands of a run through POSIX shared memory. Each
+ * island owns one slot holding its incumbent penalty and schedule; slots are
+ * written by their owner only and guarded by a sequence counter, so readers in
+ * other processes never block and retry on a torn read.
+ */
+class EliteBoard {
+public:
+    /**
+     * Opens (creating it if needed) the board `name` sized for numIslands slots
+     * of numOrders jobs. Throws std::runtime_error if an existing board was
+     * created for a different island count, instance size or instance
+     * (`fingerprint`, see instanceFingerprint). The shared-memory object is
+     * unlinked when the numIslands-th board on it is destroyed, i.e. once every
+     * island of the run has finished.
+     */
+    EliteBoard(const std::string& name, int numIslands, int numOrders, std::uint64_t fingerprint);
+    ~EliteBoard();
+
+    EliteBoard(const EliteBoard&) = delete;
+    EliteBoard& operator=(const EliteBoard&) = delete;
+
+    void publish(int island, const std::vector<int>& schedule, double penalty);
+
+    // Copies the slot of `island` into schedule/penalty; false while the slot is empty, or if its
+    // owner stays mid-write for ELITE_BOARD_READ_RETRIES attempts
+    bool read(int island, std::vector<int>& schedule, double& penalty) const;
+
+    // Removes the shared-memory object; islands that still have it mapped are unaffected
+    static void unlink(const std::string& name);
+
+private:
+    struct Header;
+    struct Slot;
+
+    Slot* slot(int island) const;
+
+    std::string name;
+    int numIslands;
+    int numOrders;
+    std::size_t slotBytes;
+    std::size_t mappedBytes;
+    void* mapping;
+};
+
+// Hash of the orders, setup times and initial setup times, never 0
+std::uint64_t instanceFingerprint(const std::vector<Order>& orders,
+                                  const SetupTimes& setupTimes,
+                                  const std::vector<int>& initialSetupTimes);
+
+/**
+ * Runs one island of a multi-process search. The island repeats GRASP
+ * iterations (greedy construction followed by ILS) and, every
+ * migrationInterval iterations, publishes its incumbent to the elite board and
+ * pulls the best foreign schedule allowed by the topology. A foreign schedule
+ * that beats the incumbent becomes the starting point of the next ILS.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param rng                Random number generator (seed it differently per island).
+ * @param islandConfig       Board name, island id/count, migration interval, epochs and topology.
+ * @param graspConfig        Lower bound and gap tolerance used for early termination.
+ * @return                   The island's best schedule and a summary of the board.
+ */
+IslandResult islandSearch(const std::vector<Order>& orders,
+                          const SetupTimes& setupTimes,
+                          const std::vector<int>& initialSetupTimes,
+                          std::mt19937& rng,
+                          const IslandConfig& islandConfig,
+                          const GraspConfig& graspConfig = GraspConfig());
+
+#endif // ISLAND_H
@@ -0,0 +1,11 @@
+// known_optima.h
+#ifndef KNOWN_OPTIMA_H
+#define KNOWN_OPTIMA_H
+
+#include <string>
+#include <unordered_map>
+
+// Published optimal penalties of the benchmark instances, keyed by file name without extension
+extern const std::unordered_map<std::string, double> optimalPenalties;
+
+#endif // KNOWN_OPTIMA_H
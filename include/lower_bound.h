@@ -0,0 +1,35 @@
+#ifndef LOWER_BOUND_H
+#define LOWER_BOUND_H
+
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+
+// The assignment relaxation is cubic in the number of orders; above this size
+// only the linear per-job bound is used.
+constexpr int LOWER_BOUND_ASSIGNMENT_MAX_ORDERS = 500;
+
+/**
+ * Smallest setup time that can precede each job when it is not the first one.
+ */
+std::vector<int> computeMinIncomingSetups(const SetupTimes& setupTimes);
+
+/**
+ * Lower bound on the penalty still to be paid by the jobs not marked in
+ * `scheduled`, when the machine becomes free at currentTime after lastTask
+ * (-1 at the start of the schedule).
+ */
+double remainingPenaltyBound(const std::vector<char>& scheduled, long long currentTime, int lastTask,
+                             const std::vector<Order>& orders,
+                             const SetupTimes& setupTimes,
+                             const std::vector<int>& initialSetupTimes,
+                             const std::vector<int>& minIncoming);
+
+/**
+ * Lower bound on the optimal total penalty of the whole instance.
+ */
+double computeLowerBound(const std::vector<Order>& orders,
+                         const SetupTimes& setupTimes,
+                         const std::vector<int>& initialSetupTimes);
+
+#endif // LOWER_BOUND_H
@@ -0,0 +1,668 @@
+// neighborhood_kernels.h
+#ifndef NEIGHBORHOOD_KERNELS_H
+#define NEIGHBORHOOD_KERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+#include "penalty.h"
+#include "batch_evaluator.h"
+#include "segment_summary.h"
+
+// Largest block moved by the swap and reinsertion neighborhoods
+constexpr int MAX_BLOCK_LENGTH = 10;
+// Longest segment reversed by a specialized 2-opt kernel; longer ones go through the schedule summary
+constexpr int MAX_REVERSAL_LENGTH = 10;
+// Largest block moved by the Or-opt and unequal block exchange neighborhoods
+constexpr int MAX_OR_OPT_LENGTH = 3;
+
+/**
+ * Completion times and accumulated penalties of every prefix of a schedule, so
+ * that a candidate only has to be re-evaluated from its first changed position.
+ */
+template <typename Cost>
+struct PrefixTimeline {
+    std::vector<long long> completion;  // completion[k]: completion time of the first k jobs
+    std::vector<Cost> penalty;          // penalty[k]: penalty of the first k jobs
+};
+
+// Best move found by a scan; penalty starts at the current schedule's penalty
+template <typename Cost>
+struct MoveCandidate {
+    Cost penalty;
+    int i = -1;
+    int j = -1;
+    int length = -1;
+    int otherLength = 0;  // Length of the block at j, for unequal block exchanges
+};
+
+template <typename Cost, typename Schedule>
+inline void buildPrefixTimeline(const Schedule& schedule, const std::vector<Order>& orders,
+                                const SetupTimes& setupTimes,
+                                const std::vector<int>& initialSetupTimes, PrefixTimeline<Cost>& timeline)
+{
+    const size_t n = schedule.size();
+    timeline.completion.assign(n + 1, 0);
+    timeline.penalty.assign(n + 1, Cost{0});
+    visitSetupModel(setupTimes, [&](const auto setups) {
+        int currentTask = -1;
+        for (size_t k = 0; k < n; ++k)
+        {
+            const int taskId = schedule[k];
+            const Order& order = orders[taskId];
+            const int setupTime = currentTask >= 0 ? setups(currentTask, taskId) : initialSetupTimes[taskId];
+            timeline.completion[k + 1] = timeline.completion[k] + setupTime + order.processingTime;
+            Cost penalty = 0;
+            if (timeline.completion[k + 1] > order.dueTime)
+            {
+                penalty = penaltyRateAs<Cost>(order) * (timeline.completion[k + 1] - order.dueTime);
+            }
+            timeline.penalty[k + 1] = timeline.penalty[k] + penalty;
+            currentTask = taskId;
+        }
+    });
+}
+
+/**
+ * Penalty of a schedule whose positions before `start` match the timeline.
+ * Penalties only accumulate, so the scan stops as soon as `cutoff` is reached.
+ */
+template <typename Cost, typename Schedule>
+inline Cost evaluateFrom(const Schedule& schedule, int start, const PrefixTimeline<Cost>& timeline,
+                         const std::vector<Order>& orders,
+                         const SetupTimes& setupTimes,
+                         const std::vector<int>& initialSetupTimes, Cost cutoff)
+{
+    const int n = schedule.size();
+    return visitSetupModel(setupTimes, [&](const auto setups) {
+        long long currentTime = timeline.completion[start];
+        Cost totalPenaltyCost = timeline.penalty[start];
+        int currentTask = start > 0 ? schedule[start - 1] : -1;
+
+        for (int k = start; k < n; ++k)
+        {
+            const int taskId = schedule[k];
+            const Order& order = orders[taskId];
+            currentTime += (currentTask >= 0 ? setups(currentTask, taskId) : initialSetupTimes[taskId]) + order.processingTime;
+            if (currentTime > order.dueTime)
+            {
+                totalPenaltyCost += penaltyRateAs<Cost>(order) * (currentTime - order.dueTime);
+                if (totalPenaltyCost >= cutoff) return totalPenaltyCost;
+            }
+            currentTask = taskId;
+        }
+        return totalPenaltyCost;
+    });
+}
+
+// ----------------------------
+// Move kernels, specialized on the block length and the schedule representation
+// ----------------------------
+
+template <int L, typename Schedule>
+inline void swapBlocks(Schedule& schedule, int i, int j)
+{
+    for (int k = 0; k < L; ++k)
+    {
+        std::swap(schedule[i + k], schedule[j + k]);
+    }
+}
+
+// Moves the block starting at `from` left so that it starts at `to` (to <= from)
+template <int L, typename Schedule>
+inline void moveBlockLeft(Schedule& schedule, int from, int to)
+{
+    std::array<typename Schedule::value_type, L> block;
+    for (int k = 0; k < L; ++k) block[k] = schedule[from + k];
+    for (int k = from - 1; k >= to; --k) schedule[k + L] = schedule[k];
+    for (int k = 0; k < L; ++k) schedule[to + k] = block[k];
+}
+
+// Moves the block starting at `from` right so that it ends at `end` (end >= from + L)
+template <int L, typename Schedule>
+inline void moveBlockRight(Schedule& schedule, int from, int end)
+{
+    std::array<typename Schedule::value_type, L> block;
+    for (int k = 0; k < L; ++k) block[k] = schedule[from + k];
+    for (int k = from + L; k < end; ++k) schedule[k - L] = schedule[k];
+    for (int k = 0; k < L; ++k) schedule[end - L + k] = block[k];
+}
+
+// Moves the block [i, i + L) so that it starts at j (j < i) or ends at j (j > i)
+template <int L, typename Schedule>
+inline void shiftBlock(Schedule& schedule, int i, int j)
+{
+    if (j < i)
+        moveBlockLeft<L>(schedule, i, j);
+    else
+        moveBlockRight<L>(schedule, i, j);
+}
+
+// Undoes shiftBlock<L>(schedule, i, j)
+template <int L, typename Schedule>
+inline void unshiftBlock(Schedule& schedule, int i, int j)
+{
+    if (j < i)
+        moveBlockRight<L>(schedule, j, i + L);
+    else
+        moveBlockLeft<L>(schedule, j - L, i);
+}
+
+template <int L, typename Schedule>
+inline void reverseSegment(Schedule& schedule, int i)
+{
+    for (int k = 0; k < L / 2; ++k)
+    {
+        std::swap(schedule[i + k], schedule[i + L - 1 - k]);
+    }
+}
+
+// Exchanges the blocks [i, i + first) and [j, j + second), j >= i + first, keeping the jobs between them in order
+template <typename Schedule>
+inline void exchangeBlocks(Schedule& schedule, int i, int first, int j, int second)
+{
+    std::rotate(schedule.begin() + i, schedule.begin() + i + first, schedule.begin() + j + second);
+    std::rotate(schedule.begin() + i, schedule.begin() + j - first, schedule.begin() + j + second - first);
+}
+
+// Moves the block [i, i + length) so that it starts at `target` of the resulting schedule, optionally reversed.
+// reinsertBlock(schedule, target, length, i, reversed) undoes it
+template <typename Schedule>
+inline void reinsertBlock(Schedule& schedule, int i, int length, int target, bool reversed)
+{
+    if (target < i)
+        std::rotate(schedule.begin() + target, schedule.begin() + i, schedule.begin() + i + length);
+    else
+        std::rotate(schedule.begin() + i, schedule.begin() + i + length, schedule.begin() + target + length);
+    if (reversed) std::reverse(schedule.begin() + target, schedule.begin() + target + length);
+}
+
+/**
+ * Exchanges every pair of non-overlapping blocks of length L in place and keeps
+ * the best exchange that improves on `best.penalty`.
+ */
+template <int L, typename Cost, typename Schedule>
+void scanBlockSwaps(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                    const std::vector<Order>& orders,
+                    const SetupTimes& setupTimes,
+                    const std::vector<int>& initialSetupTimes, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    for (int i = 0; i <= n - 2 * L; ++i)
+    {
+        for (int j = i + L; j <= n - L; ++j)
+        {
+            swapBlocks<L>(schedule, i, j);
+            const Cost newPenalty = evaluateFrom(schedule, i, timeline, orders, setupTimes, initialSetupTimes, best.penalty);
+            swapBlocks<L>(schedule, i, j);
+            if (newPenalty < best.penalty)
+            {
+                best = MoveCandidate<Cost>{newPenalty, i, j, L};
+            }
+        }
+    }
+}
+
+/**
+ * Moves every block of length L to every other position in place and keeps the
+ * best shift that improves on `best.penalty`.
+ */
+template <int L, typename Cost, typename Schedule>
+void scanBlockReinsertions(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                           const std::vector<Order>& orders,
+                           const SetupTimes& setupTimes,
+                           const std::vector<int>& initialSetupTimes, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    for (int i = 0; i <= n - L; ++i)
+    {
+        for (int j = 0; j <= n - L; ++j)
+        {
+            if (j >= i && j <= i + L - 1) continue;  // Skip overlapping positions
+
+            shiftBlock<L>(schedule, i, j);
+            const int firstChanged = std::min(i, j);
+            const Cost newPenalty = evaluateFrom(schedule, firstChanged, timeline, orders, setupTimes, initialSetupTimes, best.penalty);
+            unshiftBlock<L>(schedule, i, j);
+            if (newPenalty < best.penalty)
+            {
+                best = MoveCandidate<Cost>{newPenalty, i, j, L};
+            }
+        }
+    }
+}
+
+/**
+ * Reverses every segment of length L in place and keeps the best reversal that
+ * improves on `best.penalty`.
+ */
+template <int L, typename Cost, typename Schedule>
+void scanReversals(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                   const std::vector<Order>& orders,
+                   const SetupTimes& setupTimes,
+                   const std::vector<int>& initialSetupTimes, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    for (int i = 0; i <= n - L; ++i)
+    {
+        reverseSegment<L>(schedule, i);
+        const Cost newPenalty = evaluateFrom(schedule, i, timeline, orders, setupTimes, initialSetupTimes, best.penalty);
+        reverseSegment<L>(schedule, i);
+        if (newPenalty < best.penalty)
+        {
+            best = MoveCandidate<Cost>{newPenalty, i, i + L - 1, L};
+        }
+    }
+}
+
+// ----------------------------
+// Summary scans: candidates are assembled from pieces of the current schedule
+// and scored in O(log^2 n) per piece, whatever the pieces' lengths
+// ----------------------------
+
+/**
+ * Adds to `penalty` that of the unchanged suffix [start, n) appended at `time`
+ * after `lastTask`. A suffix that is not brought forward keeps at least its
+ * current penalty, which settles most candidates without a query.
+ *
+ * @return  The total, or a value >= cutoff once the candidate cannot improve.
+ */
+template <typename Cost, typename Schedule>
+inline Cost appendSuffix(const ScheduleSummary<Cost>& summary, const PrefixTimeline<Cost>& timeline,
+                         const Schedule& schedule, int start, const std::vector<Order>& orders,
+                         const SetupTimes& setupTimes,
+                         const std::vector<int>& initialSetupTimes, long long time, int lastTask,
+                         Cost penalty, Cost cutoff)
+{
+    const int n = schedule.size();
+    if (start >= n) return penalty;
+    const int next = schedule[start];
+    const long long nextCompletion =
+        time + setupBefore(lastTask, next, setupTimes, initialSetupTimes) + orders[next].processingTime;
+    if (nextCompletion >= timeline.completion[start + 1] &&
+        penalty + (timeline.penalty[n] - timeline.penalty[start]) >= cutoff)
+    {
+        return cutoff;
+    }
+    return penalty + appendForwardPiece(summary, schedule, start, n - 1, orders, setupTimes, initialSetupTimes,
+                                        time, lastTask);
+}
+
+/**
+ * Summary penalties are exact for IntegerPenalty. Fractional ones are summed in
+ * double and may round, so an improving candidate is re-evaluated exactly, with
+ * the move applied in place, before it is kept.
+ */
+template <typename Cost, typename Schedule, typename Apply, typename Undo>
+inline Cost confirmPenalty(Schedule& schedule, int firstChanged, const PrefixTimeline<Cost>& timeline,
+                           const std::vector<Order>& orders, const SetupTimes& setupTimes,
+                           const std::vector<int>& initialSetupTimes, Cost penalty, Cost cutoff,
+                           Apply apply, Undo undo)
+{
+    if constexpr (std::is_same_v<Cost, IntegerPenalty>)
+    {
+        return penalty;
+    }
+    else
+    {
+        apply();
+        penalty = evaluateFrom(schedule, firstChanged, timeline, orders, setupTimes, initialSetupTimes, cutoff);
+        undo();
+        return penalty;
+    }
+}
+
+/**
+ * Scores every reversal longer than MAX_REVERSAL_LENGTH: the prefix, the
+ * reversed segment and the suffix.
+ */
+template <typename Cost, typename Schedule>
+void scanLongReversals(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                       const ScheduleSummary<Cost>& summary, const std::vector<Order>& orders,
+                       const SetupTimes& setupTimes,
+                       const std::vector<int>& initialSetupTimes, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    // Prefix penalties only grow, so no segment starting at or after a prefix reaching best can improve
+    for (int i = 0; i + MAX_REVERSAL_LENGTH < n && timeline.penalty[i] < best.penalty; ++i)
+    {
+        const int previousTask = i > 0 ? schedule[i - 1] : -1;
+        for (int j = i + MAX_REVERSAL_LENGTH; j < n; ++j)
+        {
+            long long time = timeline.completion[i];
+            int lastTask = previousTask;
+            Cost newPenalty = timeline.penalty[i] + appendReversedPiece(summary, schedule, i, j, setupTimes,
+                                                                        initialSetupTimes, time, lastTask);
+            if (newPenalty >= best.penalty) continue;
+            newPenalty = appendSuffix(summary, timeline, schedule, j + 1, orders, setupTimes, initialSetupTimes,
+                                      time, lastTask, newPenalty, best.penalty);
+            if (newPenalty >= best.penalty) continue;
+
+            newPenalty = confirmPenalty(schedule, i, timeline, orders, setupTimes, initialSetupTimes, newPenalty,
+                                        best.penalty,
+                                        [&] { std::reverse(schedule.begin() + i, schedule.begin() + j + 1); },
+                                        [&] { std::reverse(schedule.begin() + i, schedule.begin() + j + 1); });
+            if (newPenalty < best.penalty)
+            {
+                best = MoveCandidate<Cost>{newPenalty, i, j, j - i + 1};
+            }
+        }
+    }
+}
+
+/**
+ * Exchanges every pair of non-overlapping blocks of different lengths up to
+ * MAX_OR_OPT_LENGTH (equal lengths are left to the swap kernels): the prefix,
+ * the block at j, the jobs between the blocks, the block at i and the suffix.
+ */
+template <typename Cost, typename Schedule>
+void scanUnequalBlockExchanges(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                               const ScheduleSummary<Cost>& summary, const std::vector<Order>& orders,
+                               const SetupTimes& setupTimes,
+                               const std::vector<int>& initialSetupTimes, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    for (int i = 0; i < n && timeline.penalty[i] < best.penalty; ++i)
+    {
+        const int previousTask = i > 0 ? schedule[i - 1] : -1;
+        for (int first = 1; first <= MAX_OR_OPT_LENGTH && i + first < n; ++first)
+        {
+            for (int second = 1; second <= MAX_OR_OPT_LENGTH; ++second)
+            {
+                if (second == first) continue;
+                for (int j = i + first; j + second <= n; ++j)
+                {
+                    long long time = timeline.completion[i];
+                    int lastTask = previousTask;
+                    Cost newPenalty = timeline.penalty[i];
+                    newPenalty += appendForwardPiece(summary, schedule, j, j + second - 1, orders, setupTimes,
+                                                     initialSetupTimes, time, lastTask);
+                    if (newPenalty >= best.penalty) continue;
+                    newPenalty += appendForwardPiece(summary, schedule, i + first, j - 1, orders, setupTimes,
+                                                     initialSetupTimes, time, lastTask);
+                    if (newPenalty >= best.penalty) continue;
+                    newPenalty += appendForwardPiece(summary, schedule, i, i + first - 1, orders, setupTimes,
+                                                     initialSetupTimes, time, lastTask);
+                    if (newPenalty >= best.penalty) continue;
+                    newPenalty = appendSuffix(summary, timeline, schedule, j + second, orders, setupTimes,
+                                              initialSetupTimes, time, lastTask, newPenalty, best.penalty);
+                    if (newPenalty >= best.penalty) continue;
+
+                    newPenalty = confirmPenalty(schedule, i, timeline, orders, setupTimes, initialSetupTimes,
+                                                newPenalty, best.penalty,
+                                                [&] { exchangeBlocks(schedule, i, first, j, second); },
+                                                [&] { exchangeBlocks(schedule, i, second, j + second - first, first); });
+                    if (newPenalty < best.penalty)
+                    {
+                        best = MoveCandidate<Cost>{newPenalty, i, j, first, second};
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Or-opt: moves every block of 2 to MAX_OR_OPT_LENGTH jobs, reversed, to every
+ * other position. Forward moves of these blocks are already scanned by the
+ * reinsertion kernels. `j` is where the block starts in the resulting schedule.
+ */
+template <typename Cost, typename Schedule>
+void scanOrOptMoves(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                    const ScheduleSummary<Cost>& summary, const std::vector<Order>& orders,
+                    const SetupTimes& setupTimes,
+                    const std::vector<int>& initialSetupTimes, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    for (int length = 2; length <= MAX_OR_OPT_LENGTH; ++length)
+    {
+        for (int i = 0; i + length <= n; ++i)
+        {
+            for (int target = 0; target + length <= n; ++target)
+            {
+                if (target == i) continue;
+                // The unchanged prefix ends at min(i, target), whose penalty never decreases along this loop
+                const int start = std::min(i, target);
+                if (timeline.penalty[start] >= best.penalty) break;
+
+                long long time = timeline.completion[start];
+                int lastTask = start > 0 ? schedule[start - 1] : -1;
+                Cost newPenalty = timeline.penalty[start];
+                if (target < i)
+                {
+                    newPenalty += appendReversedPiece(summary, schedule, i, i + length - 1, setupTimes,
+                                                      initialSetupTimes, time, lastTask);
+                    if (newPenalty >= best.penalty) continue;
+                    newPenalty += appendForwardPiece(summary, schedule, target, i - 1, orders, setupTimes,
+                                                     initialSetupTimes, time, lastTask);
+                }
+                else
+                {
+                    newPenalty += appendForwardPiece(summary, schedule, i + length, target + length - 1, orders,
+                                                     setupTimes, initialSetupTimes, time, lastTask);
+                    if (newPenalty >= best.penalty) continue;
+                    newPenalty += appendReversedPiece(summary, schedule, i, i + length - 1, setupTimes,
+                                                      initialSetupTimes, time, lastTask);
+                }
+                if (newPenalty >= best.penalty) continue;
+                newPenalty = appendSuffix(summary, timeline, schedule, std::max(i, target) + length, orders,
+                                          setupTimes, initialSetupTimes, time, lastTask, newPenalty, best.penalty);
+                if (newPenalty >= best.penalty) continue;
+
+                newPenalty = confirmPenalty(schedule, start, timeline, orders, setupTimes, initialSetupTimes,
+                                            newPenalty, best.penalty,
+                                            [&] { reinsertBlock(schedule, i, length, target, true); },
+                                            [&] { reinsertBlock(schedule, target, length, i, true); });
+                if (newPenalty < best.penalty)
+                {
+                    best = MoveCandidate<Cost>{newPenalty, i, target, length};
+                }
+            }
+        }
+    }
+}
+
+// ----------------------------
+// Batched variants: candidates sharing a prefix are scored side by side by the
+// BatchEvaluator, one lane per move, in the same order as the scalar scans
+// ----------------------------
+
+template <int L, typename Cost, typename Schedule>
+void scanBlockSwapsBatched(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                           BatchEvaluator& batch, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    const int lanes = batch.lanes();
+    double penalties[BATCH_MAX_LANES];
+    for (int i = 0; i <= n - 2 * L; ++i)
+    {
+        for (int firstJ = i + L; firstJ <= n - L; firstJ += lanes)
+        {
+            const int count = std::min(lanes, n - L - firstJ + 1);
+            batch.beginBatch(schedule, i, timeline.completion[i]);
+            for (int lane = 0; lane < count; ++lane)
+            {
+                const int j = firstJ + lane;
+                for (int k = 0; k < L; ++k)
+                {
+                    batch.setJob(i + k, lane, schedule[j + k]);
+                    batch.setJob(j + k, lane, schedule[i + k]);
+                }
+            }
+            batch.evaluate(penalties);
+            for (int lane = 0; lane < count; ++lane)
+            {
+                const Cost newPenalty = timeline.penalty[i] + static_cast<Cost>(penalties[lane]);
+                if (newPenalty < best.penalty)
+                {
+                    best = MoveCandidate<Cost>{newPenalty, i, firstJ + lane, L};
+                }
+            }
+        }
+    }
+}
+
+template <int L, typename Cost, typename Schedule>
+void scanBlockReinsertionsBatched(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                                  BatchEvaluator& batch, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    const int lanes = batch.lanes();
+    double penalties[BATCH_MAX_LANES];
+    int targets[BATCH_MAX_LANES];
+    for (int i = 0; i <= n - L; ++i)
+    {
+        int j = 0;
+        while (j <= n - L)
+        {
+            // Collect the next non-overlapping target positions
+            int count = 0;
+            for (; j <= n - L && count < lanes; ++j)
+            {
+                if (j >= i && j <= i + L - 1) continue;  // Skip overlapping positions
+                targets[count++] = j;
+            }
+            if (count == 0) break;
+
+            const int start = std::min(i, targets[0]);
+            batch.beginBatch(schedule, start, timeline.completion[start]);
+            for (int lane = 0; lane < count; ++lane)
+            {
+                const int target = targets[lane];
+                if (target < i)
+                {
+                    for (int k = 0; k < L; ++k) batch.setJob(target + k, lane, schedule[i + k]);
+                    for (int k = target; k < i; ++k) batch.setJob(k + L, lane, schedule[k]);
+                }
+                else
+                {
+                    for (int k = i + L; k < target; ++k) batch.setJob(k - L, lane, schedule[k]);
+                    for (int k = 0; k < L; ++k) batch.setJob(target - L + k, lane, schedule[i + k]);
+                }
+            }
+            batch.evaluate(penalties);
+            for (int lane = 0; lane < count; ++lane)
+            {
+                const Cost newPenalty = timeline.penalty[start] + static_cast<Cost>(penalties[lane]);
+                if (newPenalty < best.penalty)
+                {
+                    best = MoveCandidate<Cost>{newPenalty, i, targets[lane], L};
+                }
+            }
+        }
+    }
+}
+
+template <int L, typename Cost, typename Schedule>
+void scanReversalsBatched(Schedule& schedule, const PrefixTimeline<Cost>& timeline,
+                          BatchEvaluator& batch, MoveCandidate<Cost>& best)
+{
+    const int n = schedule.size();
+    const int lanes = batch.lanes();
+    double penalties[BATCH_MAX_LANES];
+    for (int firstI = 0; firstI <= n - L; firstI += lanes)
+    {
+        const int count = std::min(lanes, n - L - firstI + 1);
+        batch.beginBatch(schedule, firstI, timeline.completion[firstI]);
+        for (int lane = 0; lane < count; ++lane)
+        {
+            const int i = firstI + lane;
+            for (int k = 0; k < L; ++k) batch.setJob(i + k, lane, schedule[i + L - 1 - k]);
+        }
+        batch.evaluate(penalties);
+        for (int lane = 0; lane < count; ++lane)
+        {
+            const Cost newPenalty = timeline.penalty[firstI] + static_cast<Cost>(penalties[lane]);
+            if (newPenalty < best.penalty)
+            {
+                const int i = firstI + lane;
+                best = MoveCandidate<Cost>{newPenalty, i, i + L - 1, L};
+            }
+        }
+    }
+}
+
+// ----------------------------
+// Static dispatch tables per schedule representation (and penalty type), indexed by block length - 1
+// ----------------------------
+
+template <typename Schedule, typename Cost>
+using ScanKernel = void (*)(Schedule&, const PrefixTimeline<Cost>&, const std::vector<Order>&,
+                            const SetupTimes&, const std::vector<int>&, MoveCandidate<Cost>&);
+template <typename Schedule, typename Cost>
+using BatchScanKernel = void (*)(Schedule&, const PrefixTimeline<Cost>&, BatchEvaluator&, MoveCandidate<Cost>&);
+template <typename Schedule>
+using ApplyKernel = void (*)(Schedule&, int, int);
+
+template <typename Schedule, typename Cost, std::size_t... Ls>
+constexpr std::array<ScanKernel<Schedule, Cost>, sizeof...(Ls)> makeSwapScanTable(std::index_sequence<Ls...>)
+{
+    return {{&scanBlockSwaps<static_cast<int>(Ls) + 1, Cost, Schedule>...}};
+}
+
+template <typename Schedule, typename Cost, std::size_t... Ls>
+constexpr std::array<ScanKernel<Schedule, Cost>, sizeof...(Ls)> makeReinsertionScanTable(std::index_sequence<Ls...>)
+{
+    return {{&scanBlockReinsertions<static_cast<int>(Ls) + 1, Cost, Schedule>...}};
+}
+
+// Reversals of a single job are no-ops, so this table starts at length 2
+template <typename Schedule, typename Cost, std::size_t... Ls>
+constexpr std::array<ScanKernel<Schedule, Cost>, sizeof...(Ls)> makeReversalScanTable(std::index_sequence<Ls...>)
+{
+    return {{&scanReversals<static_cast<int>(Ls) + 2, Cost, Schedule>...}};
+}
+
+template <typename Schedule, typename Cost, std::size_t... Ls>
+constexpr std::array<BatchScanKernel<Schedule, Cost>, sizeof...(Ls)> makeSwapBatchTable(std::index_sequence<Ls...>)
+{
+    return {{&scanBlockSwapsBatched<static_cast<int>(Ls) + 1, Cost, Schedule>...}};
+}
+
+template <typename Schedule, typename Cost, std::size_t... Ls>
+constexpr std::array<BatchScanKernel<Schedule, Cost>, sizeof...(Ls)> makeReinsertionBatchTable(std::index_sequence<Ls...>)
+{
+    return {{&scanBlockReinsertionsBatched<static_cast<int>(Ls) + 1, Cost, Schedule>...}};
+}
+
+template <typename Schedule, typename Cost, std::size_t... Ls>
+constexpr std::array<BatchScanKernel<Schedule, Cost>, sizeof...(Ls)> makeReversalBatchTable(std::index_sequence<Ls...>)
+{
+    return {{&scanReversalsBatched<static_cast<int>(Ls) + 2, Cost, Schedule>...}};
+}
+
+template <typename Schedule, std::size_t... Ls>
+constexpr std::array<ApplyKernel<Schedule>, sizeof...(Ls)> makeSwapApplyTable(std::index_sequence<Ls...>)
+{
+    return {{&swapBlocks<static_cast<int>(Ls) + 1, Schedule>...}};
+}
+
+template <typename Schedule, std::size_t... Ls>
+constexpr std::array<ApplyKernel<Schedule>, sizeof...(Ls)> makeShiftApplyTable(std::index_sequence<Ls...>)
+{
+    return {{&shiftBlock<static_cast<int>(Ls) + 1, Schedule>...}};
+}
+
+template <typename Schedule, typename Cost>
+inline constexpr auto swapScanKernels = makeSwapScanTable<Schedule, Cost>(std::make_index_sequence<MAX_BLOCK_LENGTH>{});
+template <typename Schedule, typename Cost>
+inline constexpr auto reinsertionScanKernels = makeReinsertionScanTable<Schedule, Cost>(std::make_index_sequence<MAX_BLOCK_LENGTH>{});
+template <typename Schedule, typename Cost>
+inline constexpr auto reversalScanKernels = makeReversalScanTable<Schedule, Cost>(std::make_index_sequence<MAX_REVERSAL_LENGTH - 1>{});
+template <typename Schedule, typename Cost>
+inline constexpr auto swapBatchKernels = makeSwapBatchTable<Schedule, Cost>(std::make_index_sequence<MAX_BLOCK_LENGTH>{});
+template <typename Schedule, typename Cost>
+inline constexpr auto reinsertionBatchKernels = makeReinsertionBatchTable<Schedule, Cost>(std::make_index_sequence<MAX_BLOCK_LENGTH>{});
+template <typename Schedule, typename Cost>
+inline constexpr auto reversalBatchKernels = makeReversalBatchTable<Schedule, Cost>(std::make_index_sequence<MAX_REVERSAL_LENGTH - 1>{});
+template <typename Schedule>
+inline constexpr auto swapApplyKernels = makeSwapApplyTable<Schedule>(std::make_index_sequence<MAX_BLOCK_LENGTH>{});
+template <typename Schedule>
+inline constexpr auto shiftApplyKernels = makeShiftApplyTable<Schedule>(std::make_index_sequence<MAX_BLOCK_LENGTH>{});
+
+#endif // NEIGHBORHOOD_KERNELS_H
@@ -3,20 +3,38 @@
 
 #include <vector>
 #include "order.h"
+#include "setup_times.h"
 #include "schedule_data.h"
 
+// Neighborhoods are instantiated for every schedule representation in compact_schedule.h
+
 // Swap Neighborhood Function
-bool swapNeighborhood(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                      const std::vector<std::vector<int>> &setupTimes,
+template <typename Schedule>
+bool swapNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                      const SetupTimes &setupTimes,
                       const std::vector<int> &initialSetupTimes);
 // (Reinsertion) Neighborhood Function
-bool reinsertionNeighborhood(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                            const std::vector<std::vector<int>> &setupTimes,
+template <typename Schedule>
+bool reinsertionNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                            const SetupTimes &setupTimes,
                             const std::vector<int> &initialSetupTimes);
 
 // 2-Opt Neighborhood Function
-bool twoOptNeighborhood(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                        const std::vector<std::vector<int>> &setupTimes,
+template <typename Schedule>
+bool twoOptNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                        const SetupTimes &setupTimes,
                         const std::vector<int> &initialSetupTimes);
 
+// Block Exchange Neighborhood Function (blocks of different lengths)
+template <typename Schedule>
+bool blockExchangeNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                               const SetupTimes &setupTimes,
+                               const std::vector<int> &initialSetupTimes);
+
+// Or-Opt Neighborhood Function (reversed block reinsertion)
+template <typename Schedule>
+bool orOptNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                       const SetupTimes &setupTimes,
+                       const std::vector<int> &initialSetupTimes);
+
 #endif // NEIGHBORHOODS_H
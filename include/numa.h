@@ -0,0 +1,92 @@
+// numa.h
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+
+// CPUs of each NUMA node the process may run on, read from /sys/devices/system/node
+struct NumaTopology {
+    std::vector<int> nodeIds;               // Kernel node number of each entry
+    std::vector<std::vector<int>> nodeCpus;
+
+    int numNodes() const { return nodeCpus.size(); }
+};
+
+// Falls back to a single node holding every allowed CPU when sysfs has no node information
+NumaTopology detectNumaTopology();
+
+// Parses a kernel CPU list such as "0-3,8,10-11"
+std::vector<int> parseCpuList(const std::string& list);
+
+// Restricts the calling thread to the given CPUs with sched_setaffinity
+bool pinCurrentThread(const std::vector<int>& cpus);
+
+/**
+ * Binds the pages fully contained in [address, address + bytes) to a NUMA node
+ * with the mbind syscall, moving pages that were already faulted in elsewhere.
+ * Returns false if the kernel refuses (e.g. no NUMA support).
+ */
+bool bindMemoryToNode(const void* address, std::size_t bytes, int nodeId);
+
+/**
+ * Thread placement and, optionally, per-node copies of the read-only instance.
+ * Worker k runs on node k mod numNodes (spread placement), so adding workers
+ * grows all nodes evenly. Replicas are built by a thread pinned to their node,
+ * so first-touch allocation places them in that node's memory.
+ */
+class NumaContext {
+public:
+    NumaContext(const std::vector<Order>& orders,
+                const SetupTimes& setupTimes,
+                const std::vector<int>& initialSetupTimes,
+                bool replicate);
+    ~NumaContext();
+
+    const NumaTopology& topology() const { return nodes; }
+    bool replicated() const { return !replicas.empty(); }
+
+    int nodeForWorker(int worker) const { return worker % nodes.numNodes(); }
+    // Pins the calling thread to the CPUs of the worker's node
+    void pinWorker(int worker) const;
+
+    // Instance data to read on a node: its replica, or the original when not replicated
+    const std::vector<Order>& orders(int node) const;
+    const SetupTimes& setupTimes(int node) const;
+    const std::vector<int>& initialSetupTimes(int node) const;
+
+private:
+    struct Replica;
+
+    NumaTopology nodes;
+    const std::vector<Order>& sourceOrders;
+    const SetupTimes& sourceSetupTimes;
+    const std::vector<int>& sourceInitialSetupTimes;
+    std::vector<std::unique_ptr<Replica>> replicas;
+};
+
+/**
+ * Work done per NUMA node by a threaded phase; workers report once when they finish.
+ */
+class NumaThroughput {
+public:
+    explicit NumaThroughput(const NumaTopology& topology);
+
+    void addWorker(int node, long long units);
+
+    // Prints one NUMA_THROUGHPUT line per node, e.g. for windows or search nodes per second
+    void print(const std::string& phase, const std::string& unit, double seconds) const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<int> nodeIds;
+    std::vector<int> workers;
+    std::vector<long long> work;
+};
+
+#endif // NUMA_H
@@ -6,6 +6,7 @@ struct Order {
     int processingTime;
     int dueTime;
     double penaltyRate;
+    long long integerPenaltyRate;  // penaltyRate rounded to an integer, see hasIntegralPenaltyRates
 };
 
 #endif // ORDER_H
@@ -4,9 +4,10 @@
 #include <string>
 #include <vector>
 #include "order.h"
+#include "setup_times.h"
 
 void parseInputFile(const std::string& filename, std::vector<Order>& orders,
-                    std::vector<std::vector<int>>& setupTimes,
+                    SetupTimes& setupTimes,
                     std::vector<int>& initialSetupTimes);
 
 #endif // PARSER_H
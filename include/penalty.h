@@ -0,0 +1,60 @@
+// penalty.h
+#ifndef PENALTY_H
+#define PENALTY_H
+
+#include <vector>
+#include "order.h"
+
+// Penalty type used by the evaluation loop when every penalty rate is integral
+using IntegerPenalty = long long;
+
+/**
+ * True when every order's penalty rate is an integer equal to its
+ * integerPenaltyRate, so that penalties can be accumulated exactly in
+ * IntegerPenalty. Derived from the orders themselves rather than stored, so
+ * that it always describes the instance being evaluated.
+ */
+inline bool hasIntegralPenaltyRates(const std::vector<Order>& orders)
+{
+    for (const Order& order : orders)
+    {
+        if (static_cast<double>(order.integerPenaltyRate) != order.penaltyRate) return false;
+    }
+    return true;
+}
+
+template <typename Cost>
+inline Cost penaltyRateAs(const Order& order);
+
+template <>
+inline IntegerPenalty penaltyRateAs<IntegerPenalty>(const Order& order)
+{
+    return order.integerPenaltyRate;
+}
+
+template <>
+inline double penaltyRateAs<double>(const Order& order)
+{
+    return order.penaltyRate;
+}
+
+template <typename Cost>
+struct PenaltyTag {
+    using type = Cost;
+};
+
+/**
+ * Calls visitor(PenaltyTag<Cost>{}) with IntegerPenalty when the orders have
+ * integral penalty rates and with double otherwise.
+ */
+template <typename Visitor>
+decltype(auto) visitPenaltyType(const std::vector<Order>& orders, Visitor&& visitor)
+{
+    if (hasIntegralPenaltyRates(orders))
+    {
+        return visitor(PenaltyTag<IntegerPenalty>{});
+    }
+    return visitor(PenaltyTag<double>{});
+}
+
+#endif // PENALTY_H
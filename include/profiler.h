@@ -0,0 +1,63 @@
+// profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <ostream>
+#include <string>
+
+/**
+ * Phase profiler. PROFILE_SCOPE("name") times the enclosing scope with the TSC
+ * (steady_clock off x86) and, when requested and permitted, reads cycles,
+ * instructions, LLC misses and branch misses through perf_event_open. Scopes
+ * nest per thread into a call tree that is reported as a per-phase table and
+ * as folded stacks for flamegraph tools.
+ *
+ * Everything compiles to nothing unless the build defines JUICE_ENABLE_PROFILER
+ * (cmake -DJUICE_ENABLE_PROFILER=ON).
+ */
+#ifdef JUICE_ENABLE_PROFILER
+
+#include <cstdint>
+
+constexpr int PROFILE_COUNTER_COUNT = 4;  // cycles, instructions, LLC misses, branch misses
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int node;
+    std::uint64_t startTicks;
+    std::uint64_t startCounters[PROFILE_COUNTER_COUNT];
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+constexpr bool PROFILER_ENABLED = true;
+
+// Resets the collected data and starts the clock calibration; counters are opened per thread on first use
+void profilerStart(bool hardwareCounters);
+// Writes the per-phase table; call once the worker threads have finished
+void profilerReport(std::ostream& out);
+// Writes "root;child;grandchild <self microseconds>" lines merged over all threads
+bool profilerWriteFolded(const std::string& path);
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+
+constexpr bool PROFILER_ENABLED = false;
+
+inline void profilerStart(bool) {}
+inline void profilerReport(std::ostream&) {}
+inline bool profilerWriteFolded(const std::string&) { return false; }
+
+#endif // JUICE_ENABLE_PROFILER
+
+#endif // PROFILER_H
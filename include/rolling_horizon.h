@@ -0,0 +1,61 @@
+// rolling_horizon.h
+#ifndef ROLLING_HORIZON_H
+#define ROLLING_HORIZON_H
+
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+
+class NumaContext;
+
+// Positions optimized together; small enough for the compact 60-job TinySchedule
+constexpr int ROLLING_HORIZON_WINDOW = 40;
+constexpr int ROLLING_HORIZON_PASSES = 2;
+// From this many orders main() replaces the full-permutation RVND and GRASP by the decomposition
+constexpr int ROLLING_HORIZON_MIN_ORDERS = 1000;
+
+struct RollingHorizonConfig {
+    int windowSize = ROLLING_HORIZON_WINDOW;
+    int passes = ROLLING_HORIZON_PASSES;
+    bool useILS = true;   // Optimize each window with ILS; RVND alone when false
+    int numThreads = 0;   // 0 uses all hardware threads
+    const NumaContext* numa = nullptr;  // Pins workers to nodes and reads their node's instance replica
+};
+
+struct RollingHorizonStats {
+    long long windowsOptimized = 0;
+    long long windowsAccepted = 0;
+};
+
+/**
+ * Improves a schedule by optimizing windows of consecutive positions as
+ * independent sub-instances. Inside a window the start time and the
+ * predecessor job are fixed, due dates are shifted accordingly, and the last
+ * position is pinned so that the job following the window keeps its
+ * predecessor. Delaying the pinned job is charged with the weight of the tardy
+ * jobs after the window, and a new window order is accepted only if it lowers
+ * the window's penalty without delaying the pinned job. Windows that do not overlap are
+ * therefore independent and are optimized in parallel. Each pass covers the
+ * schedule twice, the second time shifted by half a window so the pinned
+ * positions move too. Work grows linearly in the number of orders.
+ *
+ * @param initialSchedule    Schedule to improve (e.g. from greedyConstruction).
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param totalPenaltyCost   Reference to store the penalty of the returned schedule.
+ * @param seed               Seed of the per-window random streams; results do not depend on the thread count.
+ * @param config             Window size, passes, window optimizer and threads.
+ * @param stats              Optional counters of optimized and accepted windows.
+ * @return                   Improved schedule.
+ */
+std::vector<int> rollingHorizonSearch(const std::vector<int>& initialSchedule,
+                                      const std::vector<Order>& orders,
+                                      const SetupTimes& setupTimes,
+                                      const std::vector<int>& initialSetupTimes,
+                                      double& totalPenaltyCost,
+                                      unsigned int seed,
+                                      const RollingHorizonConfig& config = RollingHorizonConfig(),
+                                      RollingHorizonStats* stats = nullptr);
+
+#endif // ROLLING_HORIZON_H
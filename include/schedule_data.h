@@ -4,9 +4,13 @@
 
 #include <vector>
 
-struct ScheduleData {
-    std::vector<int> schedule;
+// Schedule together with its total penalty; Schedule is std::vector<int> or a CompactSchedule
+template <typename Schedule>
+struct BasicScheduleData {
+    Schedule schedule;
     double totalPenalty;
 };
 
+using ScheduleData = BasicScheduleData<std::vector<int>>;
+
 #endif // SCHEDULE_DATA_H
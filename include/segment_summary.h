@@ -0,0 +1,231 @@
+// segment_summary.h
+#ifndef SEGMENT_SUMMARY_H
+#define SEGMENT_SUMMARY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+#include "penalty.h"
+
+/**
+ * Answers sum over k in [lo, hi) of w_k * max(0, threshold - key_k) for any range
+ * and threshold in O(log^2 n). Level l of the merge-sort tree holds the keys of
+ * every aligned block of 2^l positions in sorted order, with prefix sums of w and
+ * w * key, so a range splits into O(log n) blocks answered by a binary search each.
+ */
+template <typename Cost>
+class RangeTardinessIndex {
+public:
+    void build(const std::vector<long long>& keys, const std::vector<Cost>& weights)
+    {
+        n = keys.size();
+        levels = 1;
+        while ((1 << (levels - 1)) < n) ++levels;
+
+        sortedKeys.resize(static_cast<std::size_t>(levels) * n);
+        weightPrefix.resize(static_cast<std::size_t>(levels) * (n + 1));
+        weightedKeyPrefix.resize(static_cast<std::size_t>(levels) * (n + 1));
+        entries.resize(n);
+        merged.resize(n);
+
+        for (int k = 0; k < n; ++k) entries[k] = Entry{keys[k], weights[k]};
+        storeLevel(0);
+        for (int level = 1; level < levels; ++level)
+        {
+            const int half = 1 << (level - 1);
+            for (int start = 0; start < n; start += 2 * half)
+            {
+                const int middle = std::min(start + half, n);
+                const int end = std::min(start + 2 * half, n);
+                std::merge(entries.begin() + start, entries.begin() + middle, entries.begin() + middle,
+                           entries.begin() + end, merged.begin() + start,
+                           [](const Entry& a, const Entry& b) { return a.key < b.key; });
+            }
+            entries.swap(merged);
+            storeLevel(level);
+        }
+    }
+
+    Cost tardiness(int lo, int hi, long long threshold) const
+    {
+        Cost total = 0;
+        while (lo < hi)
+        {
+            // Largest aligned block starting at lo that stays inside the range
+            int level = 0;
+            while (level + 1 < levels && lo % (2 << level) == 0 && lo + (2 << level) <= hi) ++level;
+            const int end = lo + (1 << level);
+
+            const long long* keys = sortedKeys.data() + static_cast<std::size_t>(level) * n;
+            int count = 0;
+            if (level <= LINEAR_LEVELS)
+            {
+                for (int k = lo; k < end; ++k) count += keys[k] < threshold;
+            }
+            else
+            {
+                count = std::lower_bound(keys + lo, keys + end, threshold) - (keys + lo);
+            }
+            if (count > 0)
+            {
+                const std::size_t base = static_cast<std::size_t>(level) * (n + 1);
+                const Cost weight = weightPrefix[base + lo + count] - weightPrefix[base + lo];
+                const Cost weightedKey = weightedKeyPrefix[base + lo + count] - weightedKeyPrefix[base + lo];
+                total += static_cast<Cost>(threshold) * weight - weightedKey;
+            }
+            lo = end;
+        }
+        return total;
+    }
+
+private:
+    // Blocks of up to 2^LINEAR_LEVELS keys are counted linearly, which beats a branchy binary search
+    static constexpr int LINEAR_LEVELS = 3;
+
+    struct Entry {
+        long long key;
+        Cost weight;
+    };
+
+    void storeLevel(int level)
+    {
+        const std::size_t keyBase = static_cast<std::size_t>(level) * n;
+        const std::size_t prefixBase = static_cast<std::size_t>(level) * (n + 1);
+        weightPrefix[prefixBase] = 0;
+        weightedKeyPrefix[prefixBase] = 0;
+        for (int k = 0; k < n; ++k)
+        {
+            sortedKeys[keyBase + k] = entries[k].key;
+            weightPrefix[prefixBase + k + 1] = weightPrefix[prefixBase + k] + entries[k].weight;
+            weightedKeyPrefix[prefixBase + k + 1] =
+                weightedKeyPrefix[prefixBase + k] + entries[k].weight * static_cast<Cost>(entries[k].key);
+        }
+    }
+
+    int n = 0;
+    int levels = 0;
+    std::vector<long long> sortedKeys;
+    std::vector<Cost> weightPrefix;       // Prefix sums within each level, so block sums are differences
+    std::vector<Cost> weightedKeyPrefix;
+    std::vector<Entry> entries;
+    std::vector<Entry> merged;
+};
+
+/**
+ * Summary of a schedule from which the penalty of any contiguous piece of it,
+ * kept in order or reversed and started at any time after any task, follows in
+ * O(log^2 n) without touching the jobs inside the piece:
+ *
+ *  - forward piece [i, j]: internal setups are unchanged, so every job is shifted
+ *    by the same delta and is late by max(0, delta - slack_k) with slack_k = d_k - C_k;
+ *  - reversed piece [i, j]: with R the prefix sums of the reversed adjacent setups
+ *    and P those of the processing times, job k completes at A - (R[k] + P[k]) where
+ *    A depends only on the start, so it is late by max(0, A - (R[k] + P[k] + d_k)).
+ */
+template <typename Cost>
+struct ScheduleSummary {
+    std::vector<long long> forwardSetups;   // forwardSetups[k]: sum of setup(s[m], s[m + 1]) for m < k
+    std::vector<long long> reverseSetups;   // reverseSetups[k]: sum of setup(s[m + 1], s[m]) for m < k
+    std::vector<long long> processing;      // processing[k]: sum of p(s[m]) for m < k
+    std::vector<long long> completion;      // completion[k]: completion time of the first k jobs
+    RangeTardinessIndex<Cost> shifted;      // Keys slack_k
+    RangeTardinessIndex<Cost> reversed;     // Keys R[k] + P[k] + d_k
+    std::vector<long long> keys;
+    std::vector<Cost> weights;
+
+    // Setup time spent inside [i, j] in schedule order and in reversed order
+    long long forwardSetupLength(int i, int j) const { return forwardSetups[j] - forwardSetups[i]; }
+    long long reversedSetupLength(int i, int j) const { return reverseSetups[j] - reverseSetups[i]; }
+};
+
+template <typename Cost, typename Schedule>
+void buildScheduleSummary(const Schedule& schedule, const std::vector<Order>& orders,
+                          const SetupTimes& setupTimes,
+                          const std::vector<int>& initialSetupTimes, ScheduleSummary<Cost>& summary)
+{
+    const int n = schedule.size();
+    summary.forwardSetups.assign(n, 0);
+    summary.reverseSetups.assign(n, 0);
+    summary.processing.assign(n + 1, 0);
+    summary.completion.assign(n + 1, 0);
+    summary.keys.resize(n);
+    summary.weights.resize(n);
+
+    visitSetupModel(setupTimes, [&](const auto setups) {
+        for (int k = 0; k < n; ++k)
+        {
+            const int taskId = schedule[k];
+            const Order& order = orders[taskId];
+            if (k > 0)
+            {
+                summary.forwardSetups[k] = summary.forwardSetups[k - 1] + setups(schedule[k - 1], taskId);
+                summary.reverseSetups[k] = summary.reverseSetups[k - 1] + setups(taskId, schedule[k - 1]);
+            }
+            summary.processing[k + 1] = summary.processing[k] + order.processingTime;
+            const int setupTime = k > 0 ? setups(schedule[k - 1], taskId) : initialSetupTimes[taskId];
+            summary.completion[k + 1] = summary.completion[k] + setupTime + order.processingTime;
+            summary.weights[k] = penaltyRateAs<Cost>(order);
+        }
+    });
+
+    for (int k = 0; k < n; ++k) summary.keys[k] = orders[schedule[k]].dueTime - summary.completion[k + 1];
+    summary.shifted.build(summary.keys, summary.weights);
+
+    for (int k = 0; k < n; ++k)
+    {
+        summary.keys[k] = summary.reverseSetups[k] + summary.processing[k] + orders[schedule[k]].dueTime;
+    }
+    summary.reversed.build(summary.keys, summary.weights);
+}
+
+// Setup time before `taskId` when it follows `previousTask` (-1: first in the schedule)
+inline int setupBefore(int previousTask, int taskId, const SetupTimes& setupTimes,
+                       const std::vector<int>& initialSetupTimes)
+{
+    return previousTask >= 0 ? setupTimes[previousTask][taskId] : initialSetupTimes[taskId];
+}
+
+/**
+ * Appends positions [i, j] of the summarized schedule, in their order, to a
+ * partial schedule that ends at `time` with `lastTask`; both are advanced.
+ *
+ * @return  Penalty of the appended jobs.
+ */
+template <typename Cost, typename Schedule>
+Cost appendForwardPiece(const ScheduleSummary<Cost>& summary, const Schedule& schedule, int i, int j,
+                        const std::vector<Order>& orders, const SetupTimes& setupTimes,
+                        const std::vector<int>& initialSetupTimes, long long& time, int& lastTask)
+{
+    if (i > j) return 0;
+    const int first = schedule[i];
+    const long long firstCompletion =
+        time + setupBefore(lastTask, first, setupTimes, initialSetupTimes) + orders[first].processingTime;
+    const long long shift = firstCompletion - summary.completion[i + 1];
+    time = summary.completion[j + 1] + shift;
+    lastTask = schedule[j];
+    return summary.shifted.tardiness(i, j + 1, shift);
+}
+
+/**
+ * Appends positions [i, j] of the summarized schedule in reversed order
+ * (s[j], ..., s[i]) to a partial schedule that ends at `time` with `lastTask`.
+ *
+ * @return  Penalty of the appended jobs.
+ */
+template <typename Cost, typename Schedule>
+Cost appendReversedPiece(const ScheduleSummary<Cost>& summary, const Schedule& schedule, int i, int j,
+                         const SetupTimes& setupTimes,
+                         const std::vector<int>& initialSetupTimes, long long& time, int& lastTask)
+{
+    if (i > j) return 0;
+    const int first = schedule[j];
+    const long long anchor = time + setupBefore(lastTask, first, setupTimes, initialSetupTimes) +
+                             summary.reverseSetups[j] + summary.processing[j + 1];
+    time = anchor - summary.reverseSetups[i] - summary.processing[i];
+    lastTask = schedule[i];
+    return summary.reversed.tardiness(i, j + 1, anchor);
+}
+
+#endif // SEGMENT_SUMMARY_H
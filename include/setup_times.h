@@ -0,0 +1,135 @@
+// setup_times.h
+#ifndef SETUP_TIMES_H
+#define SETUP_TIMES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Sequence-dependent setup times between orders. A dense instance stores the
+ * full n x n order matrix; a family-clustered instance stores the family of each
+ * order and an F x F family matrix, so that setup(i, j) = S[family(i)][family(j)]
+ * and the table stays O(F^2) however many orders there are. Both are read through
+ * the same accessors: setupTimes[i][j] (row proxy, as with the former nested
+ * vectors) or setupTimes(i, j); dense tables skip the family map. Loops over a
+ * whole schedule should go through visitSetupModel, which branches on the model
+ * once instead of at every lookup.
+ */
+class SetupTimes {
+public:
+    // Setup times out of one order, indexed by the next order
+    class Row {
+    public:
+        Row(const int* row, const int* families) : row(row), families(families) {}
+        int operator[](int to) const { return row[families != nullptr ? families[to] : to]; }
+
+    private:
+        const int* row;
+        const int* families;  // nullptr for dense tables
+    };
+
+    SetupTimes() = default;
+    // Dense n x n matrix, all zero
+    explicit SetupTimes(int numOrders);
+    // Family-clustered F x F matrix, all zero; familyOf[i] in [0, numFamilies)
+    SetupTimes(std::vector<int> familyOf, int numFamilies);
+
+    // Copies and moves are new tables as far as identity() is concerned
+    SetupTimes(const SetupTimes& other);
+    SetupTimes(SetupTimes&& other) noexcept;
+    SetupTimes& operator=(const SetupTimes& other);
+    SetupTimes& operator=(SetupTimes&& other) noexcept;
+
+    int operator()(int from, int to) const
+    {
+        return isClustered ? matrix[families[from] * familyCount + families[to]] : matrix[from * familyCount + to];
+    }
+    Row operator[](int from) const
+    {
+        return isClustered ? Row(matrix.data() + families[from] * familyCount, families.data())
+                           : Row(matrix.data() + from * familyCount, nullptr);
+    }
+
+    // Number of orders
+    int size() const { return families.size(); }
+    bool clustered() const { return isClustered; }
+    // Rows of the stored matrix: F when clustered, n otherwise
+    int numFamilies() const { return familyCount; }
+    int family(int order) const { return families[order]; }
+
+    // Entry of the stored matrix (orders when dense, families when clustered)
+    int& entry(int fromFamily, int toFamily)
+    {
+        ++revision;
+        return matrix[fromFamily * familyCount + toFamily];
+    }
+    int entry(int fromFamily, int toFamily) const { return matrix[fromFamily * familyCount + toFamily]; }
+
+    // Row-major numFamilies() x numFamilies() table and the order -> row map, for bulk copies
+    const std::vector<int>& table() const { return matrix; }
+    const std::vector<int>& familyMap() const { return families; }
+
+    int maxSetup() const;
+
+    /**
+     * Distinct for every table constructed, copied or moved, and changed by every
+     * write through entry(), so that data derived from the table can be cached
+     * and rebuilt only when the table is not the one it was derived from.
+     */
+    std::pair<std::uint64_t, std::uint64_t> identity() const { return {objectId, revision}; }
+
+private:
+    static std::uint64_t newObjectId();
+
+    std::vector<int> matrix;
+    std::vector<int> families;
+    int familyCount = 0;
+    bool isClustered = false;
+    std::uint64_t objectId = newObjectId();
+    std::uint64_t revision = 0;
+};
+
+// Dense n x n table, indexed directly by order
+class DenseSetupView {
+public:
+    explicit DenseSetupView(const SetupTimes& setupTimes)
+        : matrix(setupTimes.table().data()), numOrders(setupTimes.size()) {}
+    int operator()(int from, int to) const { return matrix[from * numOrders + to]; }
+
+private:
+    const int* matrix;
+    int numOrders;
+};
+
+// F x F family table, indexed through the family of each order
+class ClusteredSetupView {
+public:
+    explicit ClusteredSetupView(const SetupTimes& setupTimes)
+        : matrix(setupTimes.table().data()), families(setupTimes.familyMap().data()),
+          numFamilies(setupTimes.numFamilies()) {}
+    int operator()(int from, int to) const { return matrix[families[from] * numFamilies + families[to]]; }
+
+private:
+    const int* matrix;
+    const int* families;
+    int numFamilies;
+};
+
+/**
+ * Calls visitor(view) with a DenseSetupView or a ClusteredSetupView of the table,
+ * so that a loop instantiated for each model reads setups without testing the
+ * model at every lookup.
+ */
+template <typename Visitor>
+decltype(auto) visitSetupModel(const SetupTimes& setupTimes, Visitor&& visitor)
+{
+    if (setupTimes.clustered())
+    {
+        return visitor(ClusteredSetupView(setupTimes));
+    }
+    return visitor(DenseSetupView(setupTimes));
+}
+
+#endif // SETUP_TIMES_H
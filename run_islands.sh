@@ -0,0 +1,62 @@
+#!/bin/bash
+# Runs one instance as N cooperating island processes sharing an elite board.
+# Usage: ./run_islands.sh <instance_file> [islands] [base_seed] [extra solver options...]
+# Example: ./run_islands.sh data/n60A.txt 4 42 --topology complete --migration-interval 1
+
+set -e
+
+BUILD_DIR="${BUILD_DIR:-build}"
+RESULTS_DIR="results/islands"
+
+instance="$1"
+islands="${2:-4}"
+base_seed="${3:-$RANDOM}"
+shift $(( $# < 3 ? $# : 3 ))
+
+if [ -z "$instance" ]; then
+    echo "Usage: $0 <instance_file> [islands] [base_seed] [extra solver options...]"
+    exit 1
+fi
+
+# Build the solver if needed
+if [ ! -x "$BUILD_DIR/juice_prod_schedule" ]; then
+    mkdir -p "$BUILD_DIR"
+    cmake -S . -B "$BUILD_DIR"
+    cmake --build "$BUILD_DIR" -j"$(nproc)"
+fi
+
+mkdir -p "$RESULTS_DIR"
+instance_name=$(basename "$instance" .txt)
+
+# One board per run, removed on exit even if an island fails
+board="/juice_elite_$$"
+trap 'rm -f "/dev/shm${board}"' EXIT
+
+pids=()
+for (( id = 0; id < islands; id++ )); do
+    "./$BUILD_DIR/juice_prod_schedule" "$instance" $((base_seed + id)) \
+        --islands "$islands" --island "$id" --board "$board" "$@" \
+        > "$RESULTS_DIR/${instance_name}_island${id}.txt" 2>&1 &
+    pids+=($!)
+done
+
+status=0
+for pid in "${pids[@]}"; do
+    wait "$pid" || status=1
+done
+
+# Best island result
+best_penalty=""
+best_island=""
+for (( id = 0; id < islands; id++ )); do
+    penalty=$(grep "ILS_GRASP_PENALTY" "$RESULTS_DIR/${instance_name}_island${id}.txt" | awk '{print $NF}')
+    echo "Island $id: $penalty"
+    if [ -n "$penalty" ] && [ "$penalty" != "N/A" ] && \
+       { [ -z "$best_penalty" ] || awk "BEGIN {exit !($penalty < $best_penalty)}"; }; then
+        best_penalty="$penalty"
+        best_island="$id"
+    fi
+done
+
+echo "$instance_name - Best penalty: $best_penalty (island $best_island), islands: $islands, base seed: $base_seed"
+exit $status
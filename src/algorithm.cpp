@@ -2,23 +2,34 @@
 
 #include "algorithm.h"
 #include "neighborhoods.h"
+#include "compact_schedule.h"
+#include "penalty.h"
+#include "profiler.h"
 #include <iostream>
 #include <chrono>
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <random>
 #include <functional>
 #include <set>
 #include <unordered_set>
 #include <deque>
 #include <queue>
-
-// Improvement counters
-int swap_improvement_count = 0;
-int block_exchange_improvement_count = 0;
-int two_opt_improvement_count = 0;
-int block_shift_improvement_count = 0;
+#include <limits>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Improvement counters, shared by every thread running local search
+std::atomic<int> swap_improvement_count{0};
+std::atomic<int> block_exchange_improvement_count{0};
+std::atomic<int> two_opt_improvement_count{0};
+std::atomic<int> block_shift_improvement_count{0};
+std::atomic<int> or_opt_improvement_count{0};
 
 /**
  * Prints the improvement statistics for the run.
@@ -30,6 +41,7 @@ void printImprovementStatistics() {
     std::cout << "Block Exchange Neighborhood: " << block_exchange_improvement_count << " improvements" << std::endl;
     std::cout << "2-Opt Neighborhood: " << two_opt_improvement_count << " improvements" << std::endl;
     std::cout << "Block Shift Neighborhood: " << block_shift_improvement_count << " improvements" << std::endl;
+    std::cout << "Or-Opt Neighborhood: " << or_opt_improvement_count << " improvements" << std::endl;
     std::cout << "=============================================" << std::endl;
 }
 
@@ -55,43 +67,51 @@ double calculatePriority(const Order &order, int setupTime)
  * @param setupTimes         Matrix of setup times between tasks.
  * @param initialSetupTimes  Vector of initial setup times.
  */
-void calculateTotalPenalty(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                           const std::vector<std::vector<int>> &setupTimes,
+template <typename Schedule>
+void calculateTotalPenalty(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                           const SetupTimes &setupTimes,
                            const std::vector<int> &initialSetupTimes)
 {
-    double totalPenaltyCost = 0.0;
-    long long int currentTime = 0;
-    int currentTask = -1;
-
-    int n = scheduleData.schedule.size();
-
-    for (size_t i = 0; i < n; ++i)
-    {
-        const int taskId = scheduleData.schedule[i];
-        const Order &order = orders[taskId];
+    PROFILE_SCOPE("evaluation");
+    scheduleData.totalPenalty = visitPenaltyType(orders, [&](auto tag) {
+        using Cost = typename decltype(tag)::type;
+        return visitSetupModel(setupTimes, [&](const auto setups) {
+            Cost totalPenaltyCost = 0;
+            long long int currentTime = 0;
+            int currentTask = -1;
 
-        int setupTime = 0;
-        if (currentTask >= 0)
-        {
-            setupTime = setupTimes[currentTask][taskId];
-        }
-        else
-        {
-            setupTime = initialSetupTimes[taskId];
-        }
-        currentTime += setupTime + order.processingTime;
+            int n = scheduleData.schedule.size();
 
-        double penalty = 0.0;
-        if (currentTime > order.dueTime)
-        {
-            penalty = order.penaltyRate * (currentTime - order.dueTime);
-        }
-        totalPenaltyCost += penalty;
-
-        currentTask = taskId;
-    }
+            for (int i = 0; i < n; ++i)
+            {
+                const int taskId = scheduleData.schedule[i];
+                const Order &order = orders[taskId];
+
+                int setupTime = 0;
+                if (currentTask >= 0)
+                {
+                    setupTime = setups(currentTask, taskId);
+                }
+                else
+                {
+                    setupTime = initialSetupTimes[taskId];
+                }
+                currentTime += setupTime + order.processingTime;
+
+                Cost penalty = 0;
+                if (currentTime > order.dueTime)
+                {
+                    penalty = penaltyRateAs<Cost>(order) * (currentTime - order.dueTime);
+                }
+                totalPenaltyCost += penalty;
+
+                currentTask = taskId;
+            }
 
-    scheduleData.totalPenalty = totalPenaltyCost;
+            // Integer penalties are stored exactly as long as they stay below 2^53
+            return static_cast<double>(totalPenaltyCost);
+        });
+    });
 }
 
 /**
@@ -100,17 +120,17 @@ void calculateTotalPenalty(ScheduleData &scheduleData, const std::vector<Order>
  * @param orders             Vector of orders.
  * @param setupTimes         Matrix of setup times between tasks.
  * @param initialSetupTimes  Vector of initial setup times.
- * @param useRCL             Flag indicating whether to use RCL-based selection.
- * @param rclSize            Size of the Restricted Candidate List (used if useRCL is true).
- * @param rng                Pointer to a random number generator (used if useRCL is true).
+ * @param alpha              Fraction of the remaining tasks in the Restricted Candidate List (0 = pure greedy).
+ * @param rng                Random number generator drawing from the RCL (nullptr = always the best task).
  * @return                   Constructed schedule as a vector of task IDs.
  */
 std::vector<int> greedyConstruction(const std::vector<Order> &orders,
-                                    const std::vector<std::vector<int>> &setupTimes,
+                                    const SetupTimes &setupTimes,
                                     const std::vector<int> &initialSetupTimes,
                                     double alpha,
                                     std::mt19937* rng)
 {
+    PROFILE_SCOPE("construction");
     const int n = orders.size();
     std::vector<int> schedule;
     std::vector<bool> scheduled(n, false);
@@ -127,37 +147,33 @@ std::vector<int> greedyConstruction(const std::vector<Order> &orders,
 
     while (!unscheduledTasks.empty())
     {
-        std::vector<TaskPriority> rcl;
-
-
-
-        // Find the top rclSize tasks
-        std::sort(unscheduledTasks.begin(),unscheduledTasks.end(),
-                          [](const TaskPriority& a, const TaskPriority& b) {
-                              return a.priority > b.priority; // Descending order
-                          });
-
         // Determine the actual RCL size based on remaining tasks
         const int actualRCLSize = alpha < 0.001 ? 1 : std::ceil(alpha * unscheduledTasks.size());
 
-
-        // Build the Restricted Candidate List (RCL)
-        for(int i = 0; i < actualRCLSize; ++i)
+        // Move the top rclSize tasks to the front; their relative order does not matter
+        // since one is drawn uniformly, so a linear-time selection replaces the full sort
+        std::nth_element(unscheduledTasks.begin(), unscheduledTasks.begin() + (actualRCLSize - 1),
+                         unscheduledTasks.end(),
+                         [](const TaskPriority& a, const TaskPriority& b) {
+                             return a.priority > b.priority; // Descending order
+                         });
+
+        // Pick from the Restricted Candidate List (RCL) with the caller's RNG, so runs repeat for a fixed seed
+        int chosenTask = 0;
+        if (rng != nullptr && actualRCLSize > 1)
         {
-            rcl.push_back(unscheduledTasks[i]);
+            chosenTask = std::uniform_int_distribution<int>(0, actualRCLSize - 1)(*rng);
         }
-        int chosenTask =  rand() % actualRCLSize;
 
-        int selectedTaskId = rcl[chosenTask].taskId;
+        int selectedTaskId = unscheduledTasks[chosenTask].taskId;
 
         // Add the selected task to the schedule
         schedule.push_back(selectedTaskId);
         scheduled[selectedTaskId] = true;
 
         // Remove the selected task from unscheduledTasks
-        unscheduledTasks.erase(std::remove_if(unscheduledTasks.begin(), unscheduledTasks.end(),
-                                              [&](const TaskPriority& tp) { return tp.taskId == selectedTaskId; }),
-                               unscheduledTasks.end());
+        unscheduledTasks[chosenTask] = unscheduledTasks.back();
+        unscheduledTasks.pop_back();
 
         // Update currentTask
         currentTask = selectedTaskId;
@@ -175,29 +191,94 @@ std::vector<int> greedyConstruction(const std::vector<Order> &orders,
 
 
 /**
- * Implements the GRASP metaheuristic for scheduling.
+ * Computes the penalty below which a schedule is considered good enough.
+ *
+ * @param config  GRASP configuration holding the lower bound and the relative gap.
+ * @return        lowerBound plus the tolerated gap (relative to max(lowerBound, 1)).
+ */
+double targetPenalty(const GraspConfig& config)
+{
+    return config.lowerBound + config.gapTolerance * std::max(config.lowerBound, 1.0);
+}
+
+/**
+ * Implements the GRASP metaheuristic for scheduling. Every iteration uses
+ * config.fixedAlpha unless config.reactive is set; in reactive mode each
+ * iteration draws alpha from GRASP_REACTIVE_ALPHAS; every GRASP_REACTIVE_PERIOD
+ * iterations the probabilities are reset proportionally to
+ * ((best + 1) / (average post-ILS penalty of alpha + 1))^GRASP_REACTIVE_EXPONENT,
+ * so that the local search is spent on the RCL sizes that lead to good optima.
  *
  * @param orders             Vector of orders.
  * @param setupTimes         Matrix of setup times between tasks.
  * @param initialSetupTimes  Vector of initial setup times.
  * @param totalPenaltyCost   Reference to store the best total penalty cost found.
  * @param rng                Random number generator.
+ * @param config             Early termination, alpha selection and dominance settings.
  * @return                   Best schedule found as a vector of task IDs.
  */
 std::vector<int> GRASP(const std::vector<Order>& orders,
-                       const std::vector<std::vector<int>>& setupTimes,
+                       const SetupTimes& setupTimes,
                        const std::vector<int>& initialSetupTimes,
                        double& totalPenaltyCost,
-                       std::mt19937& rng)
+                       std::mt19937& rng,
+                       const GraspConfig& config)
 {
+    PROFILE_SCOPE("grasp");
     constexpr int maxIterations = GRASP_ITERATIONS;
+    constexpr int numAlphas = sizeof(GRASP_REACTIVE_ALPHAS) / sizeof(GRASP_REACTIVE_ALPHAS[0]);
     std::vector<int> bestSolution;
     double bestPenaltyCost = std::numeric_limits<double>::infinity();
-    const double alpha = 0.25;
+    const double target = targetPenalty(config);
+
+    // Post-ILS penalty statistics and selection probabilities per alpha
+    std::array<double, numAlphas> penaltySum{};
+    std::array<int, numAlphas> runs{};
+    std::array<double, numAlphas> probabilities;
+    probabilities.fill(1.0 / numAlphas);
+
+    // (post-ILS penalty, construction penalty) of the best runs, best first
+    std::vector<std::pair<double, double>> elite;
+    int skippedConstructions = 0;
+
+    // Forwards only the penalties that improve on everything reported so far
+    double reportedPenalty = std::numeric_limits<double>::infinity();
+    ImprovementCallback reportImprovement;
+    if (config.onImprovement)
+    {
+        reportImprovement = [&](double penalty) {
+            if (penalty < reportedPenalty)
+            {
+                reportedPenalty = penalty;
+                config.onImprovement(penalty);
+            }
+        };
+    }
 
-    // Define RCL size (e.g., top 25% of candidates)
     for (int iter = 0; iter < maxIterations; ++iter)
     {
+        int alphaIndex = -1;
+        double alpha = config.fixedAlpha;
+        if (config.reactive)
+        {
+            // Re-weight the alphas, also after skipped iterations; one that has not been tried yet keeps the best score
+            if (iter > 0 && iter % GRASP_REACTIVE_PERIOD == 0)
+            {
+                double totalScore = 0.0;
+                for (int a = 0; a < numAlphas; ++a)
+                {
+                    const double average = runs[a] > 0 ? penaltySum[a] / runs[a] : bestPenaltyCost;
+                    probabilities[a] = std::pow((bestPenaltyCost + 1.0) / (average + 1.0), GRASP_REACTIVE_EXPONENT);
+                    totalScore += probabilities[a];
+                }
+                for (double& probability : probabilities) probability /= totalScore;
+            }
+
+            std::discrete_distribution<int> alphaDist(probabilities.begin(), probabilities.end());
+            alphaIndex = alphaDist(rng);
+            alpha = GRASP_REACTIVE_ALPHAS[alphaIndex];
+        }
+
         // Construct schedule using RCL-based selection
         std::vector<int> newSchedule = greedyConstruction(orders, setupTimes, initialSetupTimes, alpha, &rng);
 
@@ -205,24 +286,45 @@ std::vector<int> GRASP(const std::vector<Order>& orders,
         ScheduleData scheduleData;
         scheduleData.schedule = newSchedule;
         calculateTotalPenalty(scheduleData, orders, setupTimes, initialSetupTimes);
-        double iterationPenaltyCost = scheduleData.totalPenalty;
+        const double constructionPenaltyCost = scheduleData.totalPenalty;
+        if (reportImprovement) reportImprovement(constructionPenaltyCost);
+
+        // Skip the local search when the start is clearly worse than those that led to the elite
+        if (config.skipDominated && elite.size() == GRASP_ELITE_SIZE)
+        {
+            double eliteThreshold = 0.0;
+            for (const auto& entry : elite) eliteThreshold = std::max(eliteThreshold, entry.second);
+            if (constructionPenaltyCost > eliteThreshold * (1.0 + config.dominanceMargin))
+            {
+                ++skippedConstructions;
+                continue;
+            }
+        }
+
         // Apply local search with ILS
-        newSchedule = ILS(newSchedule, orders, setupTimes, initialSetupTimes, iterationPenaltyCost, rng);
+        double iterationPenaltyCost = constructionPenaltyCost;
+        newSchedule = ILS(newSchedule, orders, setupTimes, initialSetupTimes, iterationPenaltyCost, rng, target,
+                          reportImprovement, config.ilsThreads);
 
         // Recalculate the penalty cost after ILS
         ScheduleData improvedScheduleData;
         improvedScheduleData.schedule = newSchedule;
         calculateTotalPenalty(improvedScheduleData, orders, setupTimes, initialSetupTimes);
+        const double improvedPenaltyCost = improvedScheduleData.totalPenalty;
+
+        elite.emplace_back(improvedPenaltyCost, constructionPenaltyCost);
+        std::sort(elite.begin(), elite.end());
+        if (elite.size() > GRASP_ELITE_SIZE) elite.pop_back();
 
         // Update best solution if improvement is found
-        if (const double improvedPenaltyCost = improvedScheduleData.totalPenalty; improvedPenaltyCost < bestPenaltyCost)
+        if (improvedPenaltyCost < bestPenaltyCost)
         {
             bestSolution = newSchedule;
             bestPenaltyCost = improvedPenaltyCost;
 
             // Output results when a new best solution is found
             std::cout << "=============================================" << std::endl;
-            std::cout << "GRASP iteration " << iter + 1 << ": Best solution updated" << std::endl;
+            std::cout << "GRASP iteration " << iter + 1 << ": Best solution updated (alpha " << alpha << ")" << std::endl;
             std::cout << "Best Penalty: " << bestPenaltyCost << std::endl;
             std::cout << "Best Schedule: [";
             for (size_t j = 0; j < bestSolution.size(); ++j)
@@ -235,11 +337,31 @@ std::vector<int> GRASP(const std::vector<Order>& orders,
             std::cout << "=============================================" << std::endl;
         }
 
-        // Early termination if optimal solution is found
-        if (bestPenaltyCost == 0)
+        // Early termination once the incumbent is provably optimal or within the gap tolerance
+        if (bestPenaltyCost <= target)
         {
             break;
         }
+
+        if (alphaIndex >= 0)
+        {
+            penaltySum[alphaIndex] += improvedPenaltyCost;
+            ++runs[alphaIndex];
+        }
+    }
+
+    if (config.reactive)
+    {
+        for (int a = 0; a < numAlphas; ++a)
+        {
+            std::cout << "GRASP alpha " << GRASP_REACTIVE_ALPHAS[a] << ": " << runs[a] << " runs, average penalty "
+                      << (runs[a] > 0 ? std::to_string(penaltySum[a] / runs[a]) : "N/A")
+                      << ", probability " << probabilities[a] << std::endl;
+        }
+    }
+    if (config.skipDominated)
+    {
+        std::cout << "GRASP skipped " << skippedConstructions << " dominated constructions" << std::endl;
     }
 
     printImprovementStatistics();
@@ -256,17 +378,22 @@ std::vector<int> GRASP(const std::vector<Order>& orders,
  * @param initialSetupTimes  Vector of initial setup times.
  * @param rng                Random number generator.
  */
-void RVND(ScheduleData& scheduleData, const std::vector<Order>& orders,
-                  const std::vector<std::vector<int>>& setupTimes,
+template <typename Schedule>
+void RVND(BasicScheduleData<Schedule>& scheduleData, const std::vector<Order>& orders,
+                  const SetupTimes& setupTimes,
                   const std::vector<int>& initialSetupTimes, std::mt19937& rng)
 {
-    std::vector<std::function<bool(ScheduleData&, const std::vector<Order>&,
-       const std::vector<std::vector<int>> &,
-       const std::vector<int>&)>> neighborhoods = {
-        reinsertionNeighborhood,
-        swapNeighborhood,
-        twoOptNeighborhood
-};
+    PROFILE_SCOPE("rvnd");
+    // Static table of neighborhoods; shuffling plain function pointers avoids std::function dispatch
+    using Neighborhood = bool (*)(BasicScheduleData<Schedule>&, const std::vector<Order>&,
+                                  const SetupTimes&, const std::vector<int>&);
+    std::array<Neighborhood, 5> neighborhoods = {
+        reinsertionNeighborhood<Schedule>,
+        swapNeighborhood<Schedule>,
+        twoOptNeighborhood<Schedule>,
+        blockExchangeNeighborhood<Schedule>,
+        orOptNeighborhood<Schedule>
+    };
     bool improvement = true;
 
     while (improvement)
@@ -274,15 +401,11 @@ void RVND(ScheduleData& scheduleData, const std::vector<Order>& orders,
         improvement = false;
         std::shuffle(neighborhoods.begin(), neighborhoods.end(), rng);  // Shuffle neighborhoods for variability
 
-        for (const auto& neighborhood : neighborhoods)
+        for (const Neighborhood neighborhood : neighborhoods)
         {
-            // Generate a neighbor using the current neighborhood
-            ScheduleData neighborScheduleData = scheduleData; // Create a copy to test the move
-
-            if (bool moved = neighborhood(neighborScheduleData, orders, setupTimes, initialSetupTimes))
+            // Neighborhoods evaluate moves in place and only modify the schedule when they improve it
+            if (neighborhood(scheduleData, orders, setupTimes, initialSetupTimes))
             {
-                // Accept the move
-                scheduleData = std::move(neighborScheduleData);
                 improvement = true;
             }
 
@@ -300,7 +423,9 @@ void RVND(ScheduleData& scheduleData, const std::vector<Order>& orders,
  * @param schedule The current schedule to perturb.
  * @param rng      Random number generator.
  */
-void perturbSolution(std::vector<int>& schedule, std::mt19937& rng) {
+template <typename Schedule>
+void perturbSolution(Schedule& schedule, std::mt19937& rng) {
+    PROFILE_SCOPE("perturbation");
     const int n = schedule.size();
     if (n < 8) return;
 
@@ -322,47 +447,40 @@ void perturbSolution(std::vector<int>& schedule, std::mt19937& rng) {
         pos4 = n;
     }
 
-    std::vector<int> part1(schedule.begin() + pos1, schedule.begin() + pos2);
-    std::vector<int> part2(schedule.begin() + pos2, schedule.begin() + pos3);
-    std::vector<int> part3(schedule.begin() + pos3, schedule.begin() + pos4);
-
-    schedule.erase(schedule.begin() + pos1, schedule.begin() + pos4);
-
-    schedule.insert(schedule.begin() + pos1, part3.begin(), part3.end());
-    schedule.insert(schedule.begin() + pos1 + part3.size(), part1.begin(), part1.end());
-    schedule.insert(schedule.begin() + pos1 + part3.size() + part1.size(), part2.begin(), part2.end());
+    // Reorder the parts [pos1, pos2) [pos2, pos3) [pos3, pos4) as part3, part1, part2 in place
+    std::rotate(schedule.begin() + pos1, schedule.begin() + pos3, schedule.begin() + pos4);
 }
 
 /**
- * Implements the Iterated Local Search (ILS) for improving schedules.
+ * Iterated Local Search on a given schedule representation.
  *
- * @param initialSchedule    The initial schedule to start the search.
+ * @param bestScheduleData   Starting schedule; replaced by the best schedule found.
  * @param orders             Vector of orders.
  * @param setupTimes         Matrix of setup times between tasks.
  * @param initialSetupTimes  Vector of initial setup times.
- * @param currentPenaltyCost Reference to store the penalty cost after ILS.
  * @param rng                Random number generator.
- * @return                   Improved schedule as a vector of task IDs.
+ * @param targetPenalty      The search stops as soon as this penalty is reached.
+ * @param onImprovement      Optional callback invoked with every new best penalty.
  */
-std::vector<int> ILS(const std::vector<int>& initialSchedule,
-                     const std::vector<Order>& orders,
-                     const std::vector<std::vector<int>>& setupTimes,
-                     const std::vector<int>& initialSetupTimes,
-                     double& currentPenaltyCost,
-                     std::mt19937& rng)
+template <typename Schedule>
+static void iteratedLocalSearch(BasicScheduleData<Schedule>& bestScheduleData,
+                                const std::vector<Order>& orders,
+                                const SetupTimes& setupTimes,
+                                const std::vector<int>& initialSetupTimes,
+                                std::mt19937& rng,
+                                double targetPenalty,
+                                const ImprovementCallback& onImprovement)
 {
-    // Initialize best and current schedule data
-    ScheduleData bestScheduleData;
-    bestScheduleData.schedule = initialSchedule;
+    PROFILE_SCOPE("ils");
     calculateTotalPenalty(bestScheduleData, orders, setupTimes, initialSetupTimes);
     double bestPenalty = bestScheduleData.totalPenalty;
 
-    ScheduleData currentScheduleData = bestScheduleData;
+    BasicScheduleData<Schedule> currentScheduleData = bestScheduleData;
     int noImprovementCounter = 0;
 
-    int max_no_improvement_iterations = 4 * initialSchedule.size();
+    int max_no_improvement_iterations = 4 * bestScheduleData.schedule.size();
 
-    while (noImprovementCounter < max_no_improvement_iterations)
+    while (noImprovementCounter < max_no_improvement_iterations && bestPenalty > targetPenalty)
     {
         // Perform RVND local search
         RVND(currentScheduleData, orders, setupTimes, initialSetupTimes, rng);
@@ -372,6 +490,7 @@ std::vector<int> ILS(const std::vector<int>& initialSchedule,
             bestScheduleData = currentScheduleData;
             bestPenalty = currentScheduleData.totalPenalty;
             noImprovementCounter = 0;
+            if (onImprovement) onImprovement(bestPenalty);
         }
         else
         {
@@ -382,7 +501,209 @@ std::vector<int> ILS(const std::vector<int>& initialSchedule,
         perturbSolution(currentScheduleData.schedule, rng);
         calculateTotalPenalty(currentScheduleData, orders, setupTimes, initialSetupTimes);
     }
+}
+
+namespace {
+
+// Threads that run task(k) for k = 1..numWorkers-1 once per round while the caller runs task(0)
+class RoundWorkers {
+public:
+    RoundWorkers(int numWorkers, std::function<void(int)> task) : task(std::move(task))
+    {
+        for (int worker = 1; worker < numWorkers; ++worker)
+        {
+            threads.emplace_back([this, worker]() { workerLoop(worker); });
+        }
+    }
 
-    currentPenaltyCost = bestPenalty;
-    return bestScheduleData.schedule;
+    ~RoundWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        start.notify_all();
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    // Runs one round on every worker and returns once all of them are done
+    void run()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++round;
+            pending = threads.size();
+        }
+        start.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return pending == 0; });
+    }
+
+private:
+    void workerLoop(int worker)
+    {
+        unsigned seenRound = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start.wait(lock, [&]() { return stop || round != seenRound; });
+                if (stop) return;
+                seenRound = round;
+            }
+            task(worker);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) done.notify_one();
+        }
+    }
+
+    std::function<void(int)> task;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+    unsigned round = 0;
+    int pending = 0;
+    bool stop = false;
+};
+
+} // namespace
+
+/**
+ * Speculative Iterated Local Search: each round, numWorkers threads perturb the
+ * current local optimum and descend from it with RVND, and the best outcome
+ * (lowest worker on ties) becomes the new current schedule. The RNG stream of
+ * worker k in round r is seeded from (base seed, r, k), with the base drawn once
+ * from rng, so the result depends on the seed and numWorkers but not on thread
+ * timing. A round counts as numWorkers iterations towards the no-improvement
+ * limit, so the search does the same amount of descents as the sequential one.
+ *
+ * @param bestScheduleData   Starting schedule; replaced by the best schedule found.
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param rng                Random number generator.
+ * @param targetPenalty      The search stops as soon as this penalty is reached.
+ * @param onImprovement      Optional callback invoked with every new best penalty.
+ * @param numWorkers         Perturbations evaluated per round (at least 2).
+ */
+template <typename Schedule>
+static void speculativeIteratedLocalSearch(BasicScheduleData<Schedule>& bestScheduleData,
+                                           const std::vector<Order>& orders,
+                                           const SetupTimes& setupTimes,
+                                           const std::vector<int>& initialSetupTimes,
+                                           std::mt19937& rng,
+                                           double targetPenalty,
+                                           const ImprovementCallback& onImprovement,
+                                           int numWorkers)
+{
+    PROFILE_SCOPE("ils");
+    calculateTotalPenalty(bestScheduleData, orders, setupTimes, initialSetupTimes);
+    double bestPenalty = bestScheduleData.totalPenalty;
+
+    // The first descent starts from the unperturbed schedule, as in the sequential search
+    BasicScheduleData<Schedule> currentScheduleData = bestScheduleData;
+    RVND(currentScheduleData, orders, setupTimes, initialSetupTimes, rng);
+    if (currentScheduleData.totalPenalty < bestPenalty)
+    {
+        bestScheduleData = currentScheduleData;
+        bestPenalty = currentScheduleData.totalPenalty;
+        if (onImprovement) onImprovement(bestPenalty);
+    }
+
+    const std::mt19937::result_type streamSeed = rng();
+    unsigned round = 0;
+    std::vector<BasicScheduleData<Schedule>> candidates(numWorkers);
+    RoundWorkers workers(numWorkers, [&](int worker) {
+        std::seed_seq streamSeeds{streamSeed, static_cast<std::mt19937::result_type>(round),
+                                  static_cast<std::mt19937::result_type>(worker)};
+        std::mt19937 workerRng(streamSeeds);
+
+        BasicScheduleData<Schedule>& candidate = candidates[worker];
+        candidate = currentScheduleData;
+        perturbSolution(candidate.schedule, workerRng);
+        calculateTotalPenalty(candidate, orders, setupTimes, initialSetupTimes);
+        RVND(candidate, orders, setupTimes, initialSetupTimes, workerRng);
+    });
+
+    int noImprovementCounter = 0;
+    int max_no_improvement_iterations = 4 * bestScheduleData.schedule.size();
+
+    while (noImprovementCounter < max_no_improvement_iterations && bestPenalty > targetPenalty)
+    {
+        workers.run();
+        ++round;
+
+        int chosen = 0;
+        for (int worker = 1; worker < numWorkers; ++worker)
+        {
+            if (candidates[worker].totalPenalty < candidates[chosen].totalPenalty) chosen = worker;
+        }
+        std::swap(currentScheduleData, candidates[chosen]);
+
+        if (currentScheduleData.totalPenalty < bestPenalty)
+        {
+            bestScheduleData = currentScheduleData;
+            bestPenalty = currentScheduleData.totalPenalty;
+            noImprovementCounter = 0;
+            if (onImprovement) onImprovement(bestPenalty);
+        }
+        else
+        {
+            noImprovementCounter += numWorkers;
+        }
+    }
 }
+
+/**
+ * Implements the Iterated Local Search (ILS) for improving schedules. The search
+ * runs on the narrowest schedule representation that fits the instance.
+ *
+ * @param initialSchedule    The initial schedule to start the search.
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param currentPenaltyCost Reference to store the penalty cost after ILS.
+ * @param rng                Random number generator.
+ * @param targetPenalty      The search stops as soon as this penalty is reached.
+ * @param onImprovement      Optional callback invoked with every new best penalty.
+ * @param speculativeThreads Perturbations evaluated concurrently per iteration (1 = sequential ILS).
+ * @return                   Improved schedule as a vector of task IDs.
+ */
+std::vector<int> ILS(const std::vector<int>& initialSchedule,
+                     const std::vector<Order>& orders,
+                     const SetupTimes& setupTimes,
+                     const std::vector<int>& initialSetupTimes,
+                     double& currentPenaltyCost,
+                     std::mt19937& rng,
+                     double targetPenalty,
+                     const ImprovementCallback& onImprovement,
+                     int speculativeThreads)
+{
+    return visitScheduleType(initialSchedule.size(), [&](auto tag) {
+        using Schedule = typename decltype(tag)::type;
+        BasicScheduleData<Schedule> bestScheduleData{Schedule(initialSchedule), 0.0};
+        if (speculativeThreads > 1)
+        {
+            speculativeIteratedLocalSearch(bestScheduleData, orders, setupTimes, initialSetupTimes, rng, targetPenalty,
+                                           onImprovement, speculativeThreads);
+        }
+        else
+        {
+            iteratedLocalSearch(bestScheduleData, orders, setupTimes, initialSetupTimes, rng, targetPenalty, onImprovement);
+        }
+
+        currentPenaltyCost = bestScheduleData.totalPenalty;
+        return std::vector<int>(bestScheduleData.schedule.begin(), bestScheduleData.schedule.end());
+    });
+}
+
+#define INSTANTIATE_LOCAL_SEARCH(Schedule)                                                                    \
+    template void calculateTotalPenalty(BasicScheduleData<Schedule>&, const std::vector<Order>&,              \
+                                        const SetupTimes&, const std::vector<int>&);                          \
+    template void RVND(BasicScheduleData<Schedule>&, const std::vector<Order>&,                               \
+                       const SetupTimes&, const std::vector<int>&, std::mt19937&);                            \
+    template void perturbSolution(Schedule&, std::mt19937&);
+
+FOR_EACH_SCHEDULE_TYPE(INSTANTIATE_LOCAL_SEARCH)
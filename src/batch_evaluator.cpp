@@ -0,0 +1,214 @@
+// batch_evaluator.cpp
+
+#include "batch_evaluator.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define JUICE_HAS_X86_BATCH_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+#ifdef JUICE_HAS_X86_BATCH_KERNELS
+
+template <bool Clustered>
+__attribute__((target("avx2,fma")))
+void evaluateBatchAvx2(const BatchInstanceView& view, const std::int32_t* jobs, int length,
+                       std::int32_t startTime, std::int32_t previousRow, double* penalties)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i rowStride = _mm256_set1_epi32(view.numFamilies);
+    __m256i time = _mm256_set1_epi32(startTime);
+    __m256i previous = _mm256_set1_epi32(previousRow);
+    __m256d penaltyLow = _mm256_setzero_pd();
+    __m256d penaltyHigh = _mm256_setzero_pd();
+
+    for (int position = 0; position < length; ++position)
+    {
+        const __m256i job = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(jobs + position * 8));
+        const __m256i column = Clustered ? _mm256_i32gather_epi32(view.families, job, 4) : job;
+        const __m256i setupIndex = _mm256_add_epi32(_mm256_mullo_epi32(previous, rowStride), column);
+        const __m256i setup = _mm256_i32gather_epi32(view.setups, setupIndex, 4);
+        const __m256i processing = _mm256_i32gather_epi32(view.processing, job, 4);
+        const __m256i due = _mm256_i32gather_epi32(view.due, job, 4);
+
+        time = _mm256_add_epi32(time, _mm256_add_epi32(setup, processing));
+        const __m256i lateness = _mm256_max_epi32(_mm256_sub_epi32(time, due), zero);
+
+        const __m128i jobLow = _mm256_castsi256_si128(job);
+        const __m128i jobHigh = _mm256_extracti128_si256(job, 1);
+        const __m256d weightLow = _mm256_i32gather_pd(view.weights, jobLow, 8);
+        const __m256d weightHigh = _mm256_i32gather_pd(view.weights, jobHigh, 8);
+        penaltyLow = _mm256_fmadd_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(lateness)), weightLow, penaltyLow);
+        penaltyHigh = _mm256_fmadd_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(lateness, 1)), weightHigh, penaltyHigh);
+
+        previous = column;
+    }
+
+    _mm256_storeu_pd(penalties, penaltyLow);
+    _mm256_storeu_pd(penalties + 4, penaltyHigh);
+}
+
+template <bool Clustered>
+__attribute__((target("avx512f")))
+void evaluateBatchAvx512(const BatchInstanceView& view, const std::int32_t* jobs, int length,
+                         std::int32_t startTime, std::int32_t previousRow, double* penalties)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i rowStride = _mm512_set1_epi32(view.numFamilies);
+    __m512i time = _mm512_set1_epi32(startTime);
+    __m512i previous = _mm512_set1_epi32(previousRow);
+    __m512d penaltyLow = _mm512_setzero_pd();
+    __m512d penaltyHigh = _mm512_setzero_pd();
+
+    for (int position = 0; position < length; ++position)
+    {
+        const __m512i job = _mm512_loadu_si512(jobs + position * 16);
+        const __m512i column = Clustered ? _mm512_i32gather_epi32(job, view.families, 4) : job;
+        const __m512i setupIndex = _mm512_add_epi32(_mm512_mullo_epi32(previous, rowStride), column);
+        const __m512i setup = _mm512_i32gather_epi32(setupIndex, view.setups, 4);
+        const __m512i processing = _mm512_i32gather_epi32(job, view.processing, 4);
+        const __m512i due = _mm512_i32gather_epi32(job, view.due, 4);
+
+        time = _mm512_add_epi32(time, _mm512_add_epi32(setup, processing));
+        const __m512i lateness = _mm512_max_epi32(_mm512_sub_epi32(time, due), zero);
+
+        const __m256i jobLow = _mm512_castsi512_si256(job);
+        const __m256i jobHigh = _mm512_extracti64x4_epi64(job, 1);
+        const __m512d weightLow = _mm512_i32gather_pd(jobLow, view.weights, 8);
+        const __m512d weightHigh = _mm512_i32gather_pd(jobHigh, view.weights, 8);
+        penaltyLow = _mm512_fmadd_pd(_mm512_cvtepi32_pd(_mm512_castsi512_si256(lateness)), weightLow, penaltyLow);
+        penaltyHigh = _mm512_fmadd_pd(_mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(lateness, 1)), weightHigh, penaltyHigh);
+
+        previous = column;
+    }
+
+    _mm512_storeu_pd(penalties, penaltyLow);
+    _mm512_storeu_pd(penalties + 8, penaltyHigh);
+}
+
+#endif // JUICE_HAS_X86_BATCH_KERNELS
+
+struct KernelSelection {
+    BatchKernel dense;
+    BatchKernel clustered;
+    int lanes;
+    const char* name;
+};
+
+KernelSelection selectKernel()
+{
+#ifdef JUICE_HAS_X86_BATCH_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return KernelSelection{evaluateBatchAvx512<false>, evaluateBatchAvx512<true>, 16, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return KernelSelection{evaluateBatchAvx2<false>, evaluateBatchAvx2<true>, 8, "avx2"};
+    }
+#endif
+    return KernelSelection{nullptr, nullptr, 8, "scalar"};
+}
+
+const KernelSelection& selectedKernel()
+{
+    static const KernelSelection selection = selectKernel();
+    return selection;
+}
+
+} // namespace
+
+BatchEvaluator::BatchEvaluator()
+    : kernel(selectedKernel().dense), denseKernel(selectedKernel().dense), clusteredKernel(selectedKernel().clustered),
+      laneCount(selectedKernel().lanes) {}
+
+const char* BatchEvaluator::instructionSet()
+{
+    return selectedKernel().name;
+}
+
+/**
+ * Copies the instance into the flat 32-bit arrays gathered by the kernels, unless
+ * the same instance is already loaded.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ */
+void BatchEvaluator::load(const std::vector<Order>& orders,
+                          const SetupTimes& setupTimes,
+                          const std::vector<int>& initialSetupTimes)
+{
+    if (setupTimes.identity() == loadedSetups && orders.data() == loadedOrders &&
+        initialSetupTimes.data() == loadedInitialSetups && static_cast<int>(orders.size()) == loadedCount)
+    {
+        return;
+    }
+    loadedSetups = setupTimes.identity();
+    loadedOrders = orders.data();
+    loadedInitialSetups = initialSetupTimes.data();
+    loadedCount = orders.size();
+
+    n = orders.size();
+    numFamilies = setupTimes.numFamilies();
+    const std::vector<int>& table = setupTimes.table();
+    setups.resize(static_cast<std::size_t>(numFamilies + 1) * numFamilies);
+    std::copy(table.begin(), table.end(), setups.begin());
+    processing.resize(n);
+    due.resize(n);
+    weights.resize(n);
+
+    long long horizon = 0;
+    int maxSetup = setupTimes.maxSetup();
+    int minDue = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        processing[i] = orders[i].processingTime;
+        due[i] = orders[i].dueTime;
+        minDue = std::min(minDue, orders[i].dueTime);
+        weights[i] = orders[i].penaltyRate;
+        horizon += orders[i].processingTime;
+        maxSetup = std::max(maxSetup, initialSetupTimes[i]);
+    }
+    horizon += static_cast<long long>(n) * maxSetup;
+
+    // Row F holds the initial setups; a clustered table can only do so if they depend on the family alone
+    std::int32_t* initialRow = setups.data() + static_cast<std::size_t>(numFamilies) * numFamilies;
+    bool initialByRow = true;
+    if (setupTimes.clustered())
+    {
+        kernel = clusteredKernel;
+        families.assign(setupTimes.familyMap().begin(), setupTimes.familyMap().end());
+        std::vector<bool> seen(numFamilies, false);
+        for (int j = 0; j < n; ++j)
+        {
+            const int family = families[j];
+            initialByRow = initialByRow && (!seen[family] || initialRow[family] == initialSetupTimes[j]);
+            initialRow[family] = initialSetupTimes[j];
+            seen[family] = true;
+        }
+    }
+    else
+    {
+        kernel = denseKernel;
+        families.clear();
+        std::copy(initialSetupTimes.begin(), initialSetupTimes.end(), initialRow);
+    }
+
+    // Completion times, lateness and setup-matrix indices must all fit in 32-bit lanes
+    const long long laneLimit = std::numeric_limits<std::int32_t>::max();
+    fitsInLanes = initialByRow && horizon - minDue < laneLimit &&
+                  static_cast<long long>(numFamilies + 1) * numFamilies < laneLimit;
+}
+
+void BatchEvaluator::evaluate(double* penalties) const
+{
+    const int previousRow = previousTask == n ? numFamilies : (families.empty() ? previousTask : families[previousTask]);
+    kernel(BatchInstanceView{setups.data(), families.data(), processing.data(), due.data(), weights.data(), numFamilies},
+           jobs.data(), n - batchStart, static_cast<std::int32_t>(batchStartTime),
+           static_cast<std::int32_t>(previousRow), penalties);
+}
@@ -0,0 +1,688 @@
+// bench.cpp
+//
+// Time-to-quality benchmark for ILS+GRASP: runs R seeds per instance, records
+// every improvement with its time stamp and derives time-to-target (TTT)
+// distributions and primal integrals from the traces.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "algorithm.h"
+#include "known_optima.h"
+#include "lower_bound.h"
+#include "parser.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int BENCH_DEFAULT_SEEDS = 10;
+constexpr unsigned BENCH_DEFAULT_BASE_SEED = 1;
+const std::vector<double> BENCH_DEFAULT_GAPS = {0.0, 1.0, 5.0};  // Percent
+
+const double NOT_REACHED = std::numeric_limits<double>::infinity();
+
+struct BenchOptions {
+    std::vector<std::string> instances;
+    int seeds = BENCH_DEFAULT_SEEDS;
+    unsigned baseSeed = BENCH_DEFAULT_BASE_SEED;
+    std::vector<double> gaps = BENCH_DEFAULT_GAPS;
+    std::string label = "default";
+    std::string runsPath = "bench_runs.csv";
+    std::string tracePath;
+    std::string tttPath;
+    double horizon = 0.0;  // Primal-integral horizon in seconds; 0 uses the slowest run of each instance
+    bool reactiveGrasp = false;
+    double fixedAlpha = 0.25;
+    bool skipDominated = false;
+    int ilsThreads = 1;
+    bool verbose = false;
+    std::vector<std::string> compare;  // Two runs CSVs to compare instead of benchmarking
+};
+
+struct TracePoint {
+    double time;
+    double penalty;
+};
+
+struct BenchRun {
+    unsigned seed;
+    std::vector<TracePoint> trace;  // Strictly improving penalties in time order
+    double totalTime;
+};
+
+struct InstanceRuns {
+    std::string name;
+    double reference;
+    std::string referenceSource;
+    double horizon;
+    std::vector<BenchRun> runs;
+};
+
+void printUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << " [options] <instance_file_path>..." << std::endl;
+    std::cerr << "       " << program << " --compare <runs_a.csv> <runs_b.csv>" << std::endl;
+    std::cerr << "Options:" << std::endl;
+    std::cerr << "  --seeds <r>           Runs per instance (default " << BENCH_DEFAULT_SEEDS << ")" << std::endl;
+    std::cerr << "  --base-seed <s>       Seed of the first run; run k uses s + k (default " << BENCH_DEFAULT_BASE_SEED << ")" << std::endl;
+    std::cerr << "  --gaps <g1,g2,...>    Target gaps in percent for time-to-target (default 0,1,5)" << std::endl;
+    std::cerr << "  --label <name>        Build or configuration name written to every row (default \"default\")" << std::endl;
+    std::cerr << "  --out <file>          Per-run results (default bench_runs.csv)" << std::endl;
+    std::cerr << "  --trace <file>        Also write every time-stamped improvement" << std::endl;
+    std::cerr << "  --ttt <file>          Also write the empirical time-to-target distributions" << std::endl;
+    std::cerr << "  --horizon <sec>       Primal-integral horizon (default: slowest run of each instance)" << std::endl;
+    std::cerr << "  --alpha <a>           Fixed RCL size (default 0.25)" << std::endl;
+    std::cerr << "  --reactive            Pick the RCL size by reactive GRASP instead of a fixed alpha" << std::endl;
+    std::cerr << "  --skip-dominated      Skip ILS on constructions dominated by the elite ones" << std::endl;
+    std::cerr << "  --ils-threads <k>     Evaluate k ILS perturbations concurrently per iteration (default 1)" << std::endl;
+    std::cerr << "  --verbose             Keep the solver's own output" << std::endl;
+}
+
+std::vector<std::string> splitCsvLine(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ','))
+    {
+        fields.push_back(field);
+    }
+    if (!line.empty() && line.back() == ',')
+    {
+        fields.emplace_back();
+    }
+    return fields;
+}
+
+std::vector<double> parseGapList(const std::string& list)
+{
+    std::vector<double> gaps;
+    for (const std::string& gap : splitCsvLine(list))
+    {
+        gaps.push_back(std::stod(gap));
+    }
+    std::sort(gaps.begin(), gaps.end());
+    gaps.erase(std::unique(gaps.begin(), gaps.end()), gaps.end());
+    return gaps;
+}
+
+bool parseCommandLine(int argc, char *argv[], BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--seeds" && i + 1 < argc)
+        {
+            options.seeds = std::stoi(argv[++i]);
+        }
+        else if (arg == "--base-seed" && i + 1 < argc)
+        {
+            options.baseSeed = std::stoul(argv[++i]);
+        }
+        else if (arg == "--gaps" && i + 1 < argc)
+        {
+            options.gaps = parseGapList(argv[++i]);
+        }
+        else if (arg == "--label" && i + 1 < argc)
+        {
+            options.label = argv[++i];
+        }
+        else if (arg == "--out" && i + 1 < argc)
+        {
+            options.runsPath = argv[++i];
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            options.tracePath = argv[++i];
+        }
+        else if (arg == "--ttt" && i + 1 < argc)
+        {
+            options.tttPath = argv[++i];
+        }
+        else if (arg == "--horizon" && i + 1 < argc)
+        {
+            options.horizon = std::stod(argv[++i]);
+        }
+        else if (arg == "--alpha" && i + 1 < argc)
+        {
+            options.fixedAlpha = std::stod(argv[++i]);
+        }
+        else if (arg == "--reactive")
+        {
+            options.reactiveGrasp = true;
+        }
+        else if (arg == "--skip-dominated")
+        {
+            options.skipDominated = true;
+        }
+        else if (arg == "--ils-threads" && i + 1 < argc)
+        {
+            options.ilsThreads = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--verbose")
+        {
+            options.verbose = true;
+        }
+        else if (arg == "--compare" && i + 2 < argc)
+        {
+            options.compare = {argv[i + 1], argv[i + 2]};
+            i += 2;
+        }
+        else if (arg.rfind("--", 0) == 0)
+        {
+            return false;
+        }
+        else
+        {
+            options.instances.push_back(arg);
+        }
+    }
+
+    if (!options.compare.empty())
+    {
+        return options.instances.empty();
+    }
+    return !options.instances.empty() && options.seeds > 0 && options.horizon >= 0.0 &&
+           options.label.find(',') == std::string::npos;
+}
+
+// Same definition as the solver's *_GAP lines: percent above the reference, an optimum of 0 counting as 1
+double gapPercent(double penalty, double reference)
+{
+    return ((penalty - reference) / std::max(reference, 1.0)) * 100;
+}
+
+// First time the run reaches the target gap, or NOT_REACHED
+double timeToTarget(const BenchRun& run, double reference, double gap)
+{
+    for (const TracePoint& point : run.trace)
+    {
+        if (gapPercent(point.penalty, reference) <= gap + 1e-9)
+        {
+            return point.time;
+        }
+    }
+    return NOT_REACHED;
+}
+
+// Primal gap in [0, 1]: 1 before the first solution, 0 at the reference
+double primalGap(double penalty, double reference)
+{
+    if (std::fabs(penalty - reference) < 1e-9) return 0.0;
+    if (penalty * reference < 0.0) return 1.0;
+    return std::min(1.0, std::fabs(penalty - reference) / std::max(std::fabs(penalty), std::fabs(reference)));
+}
+
+/**
+ * Integrates the primal gap of a run's incumbent over [0, horizon]. The last
+ * incumbent is held after the run stops, so runs that finish early are not rewarded
+ * for stopping and a run that is still improving at the horizon is cut off there.
+ *
+ * @param run        Run with its improvement trace.
+ * @param reference  Reference penalty.
+ * @param horizon    Upper limit of the integral in seconds.
+ * @return           Primal integral in seconds; 0 means optimal from the start.
+ */
+double primalIntegral(const BenchRun& run, double reference, double horizon)
+{
+    double integral = 0.0;
+    double previousTime = 0.0;
+    double currentGap = 1.0;
+    for (const TracePoint& point : run.trace)
+    {
+        const double time = std::min(point.time, horizon);
+        integral += currentGap * (time - previousTime);
+        previousTime = time;
+        currentGap = primalGap(point.penalty, reference);
+    }
+    integral += currentGap * std::max(0.0, horizon - previousTime);
+    return integral;
+}
+
+double finalPenalty(const BenchRun& run)
+{
+    return run.trace.empty() ? NOT_REACHED : run.trace.back().penalty;
+}
+
+double median(std::vector<double> values)
+{
+    if (values.empty()) return NOT_REACHED;
+    std::sort(values.begin(), values.end());
+    const size_t middle = values.size() / 2;
+    return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+std::string formatValue(double value)
+{
+    if (std::isinf(value)) return "";
+    std::ostringstream stream;
+    stream << std::setprecision(10) << value;
+    return stream.str();
+}
+
+std::string gapColumn(double gap)
+{
+    return "ttt_" + formatValue(gap);
+}
+
+/**
+ * Runs ILS+GRASP once per seed on one instance with the solver's output silenced.
+ *
+ * @param filepath  Instance file.
+ * @param options   Benchmark options.
+ * @return          Traces of all runs, without reference or horizon.
+ */
+InstanceRuns benchmarkInstance(const std::string& filepath, const BenchOptions& options)
+{
+    std::vector<Order> orders;
+    SetupTimes setupTimes;
+    std::vector<int> initialSetupTimes;
+    parseInputFile(filepath, orders, setupTimes, initialSetupTimes);
+
+    InstanceRuns instance;
+    const std::string filename = fs::path(filepath).filename().string();
+    instance.name = filename.substr(0, filename.find('.'));
+
+    GraspConfig graspConfig;
+    graspConfig.lowerBound = computeLowerBound(orders, setupTimes, initialSetupTimes);
+    graspConfig.reactive = options.reactiveGrasp;
+    graspConfig.fixedAlpha = options.fixedAlpha;
+    graspConfig.skipDominated = options.skipDominated;
+    graspConfig.ilsThreads = options.ilsThreads;
+
+    for (int k = 0; k < options.seeds; ++k)
+    {
+        BenchRun run;
+        run.seed = options.baseSeed + k;
+        std::mt19937 rng(run.seed);
+
+        const auto start = std::chrono::steady_clock::now();
+        graspConfig.onImprovement = [&run, start](double penalty) {
+            const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            run.trace.push_back(TracePoint{time, penalty});
+        };
+
+        std::streambuf* console = std::cout.rdbuf();
+        if (!options.verbose) std::cout.rdbuf(nullptr);
+        double penalty = 0.0;
+        GRASP(orders, setupTimes, initialSetupTimes, penalty, rng, graspConfig);
+        std::cout.rdbuf(console);
+
+        run.totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << instance.name << " seed " << run.seed << ": penalty " << finalPenalty(run) << " in "
+                  << std::fixed << std::setprecision(3) << run.totalTime << std::defaultfloat << std::setprecision(6)
+                  << " s (" << run.trace.size() << " improvements)" << std::endl;
+        instance.runs.push_back(std::move(run));
+    }
+
+    // Reference: published optimum, else the best penalty any of these runs reached
+    const auto known = optimalPenalties.find(instance.name);
+    if (known != optimalPenalties.end())
+    {
+        instance.reference = known->second;
+        instance.referenceSource = "TABLE";
+    }
+    else
+    {
+        instance.reference = NOT_REACHED;
+        for (const BenchRun& run : instance.runs)
+        {
+            instance.reference = std::min(instance.reference, finalPenalty(run));
+        }
+        instance.referenceSource = "BEST_FOUND";
+    }
+
+    instance.horizon = options.horizon;
+    if (instance.horizon <= 0.0)
+    {
+        for (const BenchRun& run : instance.runs)
+        {
+            instance.horizon = std::max(instance.horizon, run.totalTime);
+        }
+    }
+    return instance;
+}
+
+bool writeRuns(const std::string& path, const std::vector<InstanceRuns>& instances, const BenchOptions& options)
+{
+    std::ofstream file(path);
+    if (!file) return false;
+    file << "label,instance,seed,final_penalty,time_to_final,total_time,reference,reference_source,"
+            "gap_percent,primal_integral,horizon";
+    for (double gap : options.gaps) file << "," << gapColumn(gap);
+    file << "\n";
+
+    for (const InstanceRuns& instance : instances)
+    {
+        for (const BenchRun& run : instance.runs)
+        {
+            const double penalty = finalPenalty(run);
+            file << options.label << "," << instance.name << "," << run.seed << "," << formatValue(penalty) << ","
+                 << formatValue(run.trace.empty() ? NOT_REACHED : run.trace.back().time) << ","
+                 << formatValue(run.totalTime) << "," << formatValue(instance.reference) << ","
+                 << instance.referenceSource << "," << formatValue(gapPercent(penalty, instance.reference)) << ","
+                 << formatValue(primalIntegral(run, instance.reference, instance.horizon)) << ","
+                 << formatValue(instance.horizon);
+            for (double gap : options.gaps)
+            {
+                file << "," << formatValue(timeToTarget(run, instance.reference, gap));
+            }
+            file << "\n";
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+bool writeTrace(const std::string& path, const std::vector<InstanceRuns>& instances, const BenchOptions& options)
+{
+    std::ofstream file(path);
+    if (!file) return false;
+    file << "label,instance,seed,time,penalty,gap_percent\n";
+    for (const InstanceRuns& instance : instances)
+    {
+        for (const BenchRun& run : instance.runs)
+        {
+            for (const TracePoint& point : run.trace)
+            {
+                file << options.label << "," << instance.name << "," << run.seed << "," << formatValue(point.time)
+                     << "," << formatValue(point.penalty) << ","
+                     << formatValue(gapPercent(point.penalty, instance.reference)) << "\n";
+            }
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * Writes the empirical TTT distribution of every instance and target gap:
+ * the i-th fastest of R runs is plotted at probability (i - 0.5) / R, so
+ * runs that never reach the target cap the curve below 1.
+ */
+bool writeTimeToTarget(const std::string& path, const std::vector<InstanceRuns>& instances, const BenchOptions& options)
+{
+    std::ofstream file(path);
+    if (!file) return false;
+    file << "label,instance,target_gap,rank,time,probability\n";
+    for (const InstanceRuns& instance : instances)
+    {
+        for (double gap : options.gaps)
+        {
+            std::vector<double> times;
+            for (const BenchRun& run : instance.runs)
+            {
+                const double time = timeToTarget(run, instance.reference, gap);
+                if (!std::isinf(time)) times.push_back(time);
+            }
+            std::sort(times.begin(), times.end());
+            for (size_t i = 0; i < times.size(); ++i)
+            {
+                file << options.label << "," << instance.name << "," << formatValue(gap) << "," << i + 1 << ","
+                     << formatValue(times[i]) << "," << formatValue((i + 0.5) / instance.runs.size()) << "\n";
+            }
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+void printSummary(const std::vector<InstanceRuns>& instances, const BenchOptions& options)
+{
+    std::cout << "=============================================" << std::endl;
+    std::cout << "Benchmark \"" << options.label << "\": " << options.seeds << " seeds per instance" << std::endl;
+    for (const InstanceRuns& instance : instances)
+    {
+        double totalGap = 0.0;
+        double totalIntegral = 0.0;
+        for (const BenchRun& run : instance.runs)
+        {
+            totalGap += gapPercent(finalPenalty(run), instance.reference);
+            totalIntegral += primalIntegral(run, instance.reference, instance.horizon);
+        }
+        const double numRuns = instance.runs.size();
+        std::cout << instance.name << " (reference " << instance.reference << ", " << instance.referenceSource
+                  << "): mean gap " << totalGap / numRuns << "%, mean primal integral " << totalIntegral / numRuns
+                  << " over " << instance.horizon << " s" << std::endl;
+
+        for (double gap : options.gaps)
+        {
+            std::vector<double> times;
+            for (const BenchRun& run : instance.runs)
+            {
+                times.push_back(timeToTarget(run, instance.reference, gap));
+            }
+            const long reached = std::count_if(times.begin(), times.end(), [](double t) { return !std::isinf(t); });
+            const double medianTime = median(times);
+            std::cout << "  gap <= " << gap << "%: reached " << reached << "/" << times.size() << ", median TTT "
+                      << (std::isinf(medianTime) ? std::string("not reached") : formatValue(medianTime) + " s")
+                      << std::endl;
+        }
+    }
+    std::cout << "=============================================" << std::endl;
+}
+
+// ----------------------------
+// Comparison of two runs CSVs
+// ----------------------------
+
+struct RunsTable {
+    std::string label;
+    std::vector<double> gaps;  // Target gaps of the ttt_* columns
+    // Per instance: one row of parsed values per run
+    std::map<std::string, std::vector<std::map<std::string, std::string>>> rows;
+};
+
+RunsTable readRunsTable(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot read " + path);
+    }
+
+    RunsTable table;
+    std::string line;
+    std::getline(file, line);
+    const std::vector<std::string> header = splitCsvLine(line);
+    for (const std::string& column : header)
+    {
+        if (column.rfind("ttt_", 0) == 0) table.gaps.push_back(std::stod(column.substr(4)));
+    }
+
+    while (std::getline(file, line))
+    {
+        if (line.empty()) continue;
+        const std::vector<std::string> fields = splitCsvLine(line);
+        if (fields.size() != header.size())
+        {
+            throw std::runtime_error("Malformed row in " + path + ": " + line);
+        }
+        std::map<std::string, std::string> row;
+        for (size_t k = 0; k < header.size(); ++k) row[header[k]] = fields[k];
+        table.label = row["label"];
+        table.rows[row["instance"]].push_back(std::move(row));
+    }
+    return table;
+}
+
+double fieldValue(const std::map<std::string, std::string>& row, const std::string& column)
+{
+    const auto field = row.find(column);
+    return field == row.end() || field->second.empty() ? NOT_REACHED : std::stod(field->second);
+}
+
+struct TableStats {
+    double meanGap = 0.0;
+    double meanIntegral = 0.0;
+    double reference = 0.0;
+    double horizon = 0.0;
+    std::vector<long> reached;
+    std::vector<double> medianTime;
+};
+
+TableStats instanceStats(const std::vector<std::map<std::string, std::string>>& rows, const std::vector<double>& gaps)
+{
+    TableStats stats;
+    for (const auto& row : rows)
+    {
+        stats.meanGap += fieldValue(row, "gap_percent") / rows.size();
+        stats.meanIntegral += fieldValue(row, "primal_integral") / rows.size();
+        stats.reference = fieldValue(row, "reference");
+        stats.horizon = fieldValue(row, "horizon");
+    }
+    for (double gap : gaps)
+    {
+        std::vector<double> times;
+        for (const auto& row : rows) times.push_back(fieldValue(row, gapColumn(gap)));
+        stats.reached.push_back(std::count_if(times.begin(), times.end(), [](double t) { return !std::isinf(t); }));
+        stats.medianTime.push_back(median(times));
+    }
+    return stats;
+}
+
+// Report cell: six significant digits, "-" for a missing value
+std::string formatCell(double value)
+{
+    if (std::isinf(value)) return "-";
+    std::ostringstream stream;
+    stream << std::setprecision(6) << value;
+    return stream.str();
+}
+
+/**
+ * Prints both configurations side by side for every instance they share:
+ * mean final gap, mean primal integral, and per target gap the success rate
+ * and median TTT (a median of "-" means fewer than half the runs got there).
+ *
+ * @param pathA  Runs CSV of the baseline.
+ * @param pathB  Runs CSV of the candidate.
+ * @return       Process exit code.
+ */
+int compareRuns(const std::string& pathA, const std::string& pathB)
+{
+    const RunsTable a = readRunsTable(pathA);
+    const RunsTable b = readRunsTable(pathB);
+
+    std::vector<double> gaps;
+    std::set_intersection(a.gaps.begin(), a.gaps.end(), b.gaps.begin(), b.gaps.end(), std::back_inserter(gaps));
+
+    std::cout << "=============================================" << std::endl;
+    std::cout << "Comparison: A = \"" << a.label << "\" (" << pathA << "), B = \"" << b.label << "\" (" << pathB << ")"
+              << std::endl;
+    std::cout << std::left << std::setw(28) << "Metric" << std::right << std::setw(14) << "A" << std::setw(14) << "B"
+              << std::setw(14) << "B - A" << std::endl;
+
+    auto printRow = [](const std::string& name, double valueA, double valueB) {
+        const bool comparable = !std::isinf(valueA) && !std::isinf(valueB);
+        std::cout << std::left << std::setw(28) << name << std::right << std::setw(14) << formatCell(valueA)
+                  << std::setw(14) << formatCell(valueB) << std::setw(14)
+                  << formatCell(comparable ? valueB - valueA : NOT_REACHED) << std::endl;
+    };
+
+    int shared = 0;
+    for (const auto& [instance, rowsA] : a.rows)
+    {
+        const auto rowsB = b.rows.find(instance);
+        if (rowsB == b.rows.end()) continue;
+        ++shared;
+
+        const TableStats statsA = instanceStats(rowsA, gaps);
+        const TableStats statsB = instanceStats(rowsB->second, gaps);
+        std::cout << "--- " << instance << " (" << rowsA.size() << " vs " << rowsB->second.size() << " runs)" << std::endl;
+        if (statsA.reference != statsB.reference)
+        {
+            std::cout << "Warning: references differ (" << statsA.reference << " vs " << statsB.reference
+                      << "); gaps are not comparable" << std::endl;
+        }
+        if (statsA.horizon != statsB.horizon)
+        {
+            std::cout << "Warning: horizons differ (" << statsA.horizon << " vs " << statsB.horizon
+                      << " s); rerun both with the same --horizon" << std::endl;
+        }
+        printRow("mean gap %", statsA.meanGap, statsB.meanGap);
+        printRow("mean primal integral", statsA.meanIntegral, statsB.meanIntegral);
+        for (size_t g = 0; g < gaps.size(); ++g)
+        {
+            const std::string target = "gap <= " + formatValue(gaps[g]) + "%";
+            printRow(target + " success %", 100.0 * statsA.reached[g] / rowsA.size(),
+                     100.0 * statsB.reached[g] / rowsB->second.size());
+            printRow(target + " median TTT", statsA.medianTime[g], statsB.medianTime[g]);
+        }
+    }
+    std::cout << "=============================================" << std::endl;
+
+    if (shared == 0)
+    {
+        std::cerr << "Error: the two files have no instance in common" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    try
+    {
+        if (!parseCommandLine(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (!options.compare.empty())
+    {
+        try
+        {
+            return compareRuns(options.compare[0], options.compare[1]);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<InstanceRuns> instances;
+    for (const std::string& filepath : options.instances)
+    {
+        if (!fs::exists(filepath))
+        {
+            std::cerr << "Error: File does not exist: " << filepath << std::endl;
+            return 1;
+        }
+        instances.push_back(benchmarkInstance(filepath, options));
+    }
+
+    printSummary(instances, options);
+
+    bool written = writeRuns(options.runsPath, instances, options);
+    if (!options.tracePath.empty()) written = writeTrace(options.tracePath, instances, options) && written;
+    if (!options.tttPath.empty()) written = writeTimeToTarget(options.tttPath, instances, options) && written;
+    if (!written)
+    {
+        std::cerr << "Error: cannot write benchmark results" << std::endl;
+        return 1;
+    }
+    std::cout << "BENCH_RUNS: " << options.runsPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,585 @@
+// exact_solver.cpp
+
+#include "exact_solver.h"
+#include "algorithm.h"
+#include "lower_bound.h"
+#include "numa.h"
+#include "profiler.h"
+#include "schedule_data.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double incumbentPenalty(const std::vector<int>& incumbentSchedule, const std::vector<Order>& orders,
+                        const SetupTimes& setupTimes,
+                        const std::vector<int>& initialSetupTimes)
+{
+    if (incumbentSchedule.size() != orders.size())
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    ScheduleData incumbentData;
+    incumbentData.schedule = incumbentSchedule;
+    calculateTotalPenalty(incumbentData, orders, setupTimes, initialSetupTimes);
+    return incumbentData.totalPenalty;
+}
+
+// ----------------------------
+// Bitmask dynamic program
+// ----------------------------
+
+struct Label {
+    long long time;   // Completion time of the last job
+    double cost;      // Penalty accumulated so far
+    int task;         // Last job of the partial sequence
+    int parent;       // Index of the predecessor label in the arena, -1 for the first job
+};
+
+// ----------------------------
+// Branch-and-bound
+// ----------------------------
+
+struct SearchTask {
+    std::vector<int> prefix;
+    double bound;
+};
+
+struct SharedSearchState {
+    std::mutex incumbentMutex;
+    std::atomic<double> upperBound{std::numeric_limits<double>::infinity()};
+    std::vector<int> bestSchedule;
+    std::atomic<long long> nodesExplored{0};
+    std::atomic<bool> timedOut{false};
+    std::atomic<size_t> nextTask{0};
+    Clock::time_point deadline;
+};
+
+class BranchAndBoundWorker {
+public:
+    BranchAndBoundWorker(const std::vector<Order>& orders,
+                         const SetupTimes& setupTimes,
+                         const std::vector<int>& initialSetupTimes,
+                         const std::vector<int>& minIncoming,
+                         SharedSearchState& shared)
+        : orders(orders), setupTimes(setupTimes), initialSetupTimes(initialSetupTimes),
+          minIncoming(minIncoming), shared(shared), n(orders.size()),
+          scheduled(n, 0), timeAt(n + 1, 0), costAt(n + 1, 0.0) {}
+
+    // Nodes created by this worker, for per-NUMA-node throughput
+    long long nodesVisited() const { return visited; }
+
+    /**
+     * Fully explores the subtree below the given prefix.
+     *
+     * @return False if the search was interrupted by the time limit.
+     */
+    bool explore(const std::vector<int>& prefix)
+    {
+        std::fill(scheduled.begin(), scheduled.end(), 0);
+        sequence.clear();
+        mask = 0;
+        for (int task : prefix)
+        {
+            const int depth = sequence.size();
+            const int setupTime = depth > 0 ? setupTimes[sequence.back()][task] : initialSetupTimes[task];
+            timeAt[depth + 1] = timeAt[depth] + setupTime + orders[task].processingTime;
+            const long long lateness = timeAt[depth + 1] - orders[task].dueTime;
+            costAt[depth + 1] = costAt[depth] + (lateness > 0 ? orders[task].penaltyRate * lateness : 0.0);
+            push(task);
+        }
+        search();
+        return !shared.timedOut.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Child {
+        int task;
+        long long time;
+        double cost;
+        double bound;
+    };
+
+    void push(int task)
+    {
+        sequence.push_back(task);
+        scheduled[task] = 1;
+        if (n <= 64) mask |= uint64_t{1} << task;
+    }
+
+    void pop()
+    {
+        const int task = sequence.back();
+        sequence.pop_back();
+        scheduled[task] = 0;
+        if (n <= 64) mask &= ~(uint64_t{1} << task);
+    }
+
+    // Returns true if an already expanded node with the same job set and last job dominates this one
+    bool dominatedByMemo(int task, long long time, double cost)
+    {
+        if (n > 64) return false;
+        const auto it = memo.find({mask, task});
+        if (it == memo.end()) return false;
+        for (const auto& [seenTime, seenCost] : it->second)
+        {
+            if (seenTime <= time && seenCost <= cost) return true;
+        }
+        return false;
+    }
+
+    void remember(int task, long long time, double cost)
+    {
+        if (n > 64) return;
+        if (memo.size() >= EXACT_MEMO_MAX_ENTRIES) memo.clear();
+        auto& labels = memo[{mask, task}];
+        labels.erase(std::remove_if(labels.begin(), labels.end(),
+                                    [&](const std::pair<long long, double>& label) {
+                                        return label.first >= time && label.second >= cost;
+                                    }),
+                     labels.end());
+        labels.emplace_back(time, cost);
+    }
+
+    // Adjacent pairwise interchange: swapping the two jobs before `task` must not
+    // give a strictly better partial sequence ending in `task`.
+    bool dominatedByInterchange(int task, long long time, double cost) const
+    {
+        const int depth = sequence.size();
+        if (depth < 2) return false;
+        const int a = sequence[depth - 2];
+        const int b = sequence[depth - 1];
+        const int before = depth >= 3 ? sequence[depth - 3] : -1;
+
+        long long t = timeAt[depth - 2];
+        double c = costAt[depth - 2];
+        t += (before >= 0 ? setupTimes[before][b] : initialSetupTimes[b]) + orders[b].processingTime;
+        c += t > orders[b].dueTime ? orders[b].penaltyRate * (t - orders[b].dueTime) : 0.0;
+        t += setupTimes[b][a] + orders[a].processingTime;
+        c += t > orders[a].dueTime ? orders[a].penaltyRate * (t - orders[a].dueTime) : 0.0;
+        t += setupTimes[a][task] + orders[task].processingTime;
+        c += t > orders[task].dueTime ? orders[task].penaltyRate * (t - orders[task].dueTime) : 0.0;
+
+        return t <= time && c <= cost && (t < time || c < cost);
+    }
+
+    void offerSolution(double cost)
+    {
+        std::lock_guard<std::mutex> lock(shared.incumbentMutex);
+        if (cost < shared.upperBound.load())
+        {
+            shared.upperBound.store(cost);
+            shared.bestSchedule = sequence;
+        }
+    }
+
+    void search()
+    {
+        const int depth = sequence.size();
+        ++visited;
+        if ((shared.nodesExplored.fetch_add(1, std::memory_order_relaxed) & 4095) == 0 &&
+            Clock::now() > shared.deadline)
+        {
+            shared.timedOut.store(true);
+        }
+        if (shared.timedOut.load(std::memory_order_relaxed)) return;
+
+        if (depth == n)
+        {
+            offerSolution(costAt[depth]);
+            return;
+        }
+
+        const int last = depth > 0 ? sequence.back() : -1;
+        std::vector<Child> children;
+        children.reserve(n - depth);
+        for (int task = 0; task < n; ++task)
+        {
+            if (scheduled[task]) continue;
+            const int setupTime = last >= 0 ? setupTimes[last][task] : initialSetupTimes[task];
+            const long long time = timeAt[depth] + setupTime + orders[task].processingTime;
+            const double cost = costAt[depth] + (time > orders[task].dueTime ? orders[task].penaltyRate * (time - orders[task].dueTime) : 0.0);
+
+            if (cost >= shared.upperBound.load(std::memory_order_relaxed)) continue;
+            if (dominatedByInterchange(task, time, cost)) continue;
+
+            scheduled[task] = 1;
+            const double bound = cost + remainingPenaltyBound(scheduled, time, task, orders, setupTimes,
+                                                              initialSetupTimes, minIncoming);
+            scheduled[task] = 0;
+            if (bound >= shared.upperBound.load(std::memory_order_relaxed)) continue;
+
+            children.push_back(Child{task, time, cost, bound});
+        }
+
+        std::sort(children.begin(), children.end(),
+                  [](const Child& a, const Child& b) { return a.bound < b.bound; });
+
+        for (const Child& child : children)
+        {
+            if (child.bound >= shared.upperBound.load(std::memory_order_relaxed)) break;
+
+            push(child.task);
+            if (!dominatedByMemo(child.task, child.time, child.cost))
+            {
+                remember(child.task, child.time, child.cost);
+                timeAt[depth + 1] = child.time;
+                costAt[depth + 1] = child.cost;
+                search();
+            }
+            pop();
+            if (shared.timedOut.load(std::memory_order_relaxed)) return;
+        }
+    }
+
+    const std::vector<Order>& orders;
+    const SetupTimes& setupTimes;
+    const std::vector<int>& initialSetupTimes;
+    const std::vector<int>& minIncoming;
+    SharedSearchState& shared;
+    const int n;
+
+    std::vector<int> sequence;
+    std::vector<char> scheduled;
+    std::vector<long long> timeAt;   // timeAt[k]: completion time of the first k jobs
+    std::vector<double> costAt;      // costAt[k]: penalty of the first k jobs
+    uint64_t mask = 0;
+    long long visited = 0;
+    std::unordered_map<std::pair<uint64_t, int>, std::vector<std::pair<long long, double>>, pair_hash> memo;
+};
+
+/**
+ * Enumerates the prefixes of length splitDepth that survive bound pruning,
+ * which become the independent subtrees handed to the worker threads.
+ */
+void collectSearchTasks(std::vector<int>& prefix, std::vector<char>& scheduled, long long time, double cost,
+                        int splitDepth, double upperBound,
+                        const std::vector<Order>& orders,
+                        const SetupTimes& setupTimes,
+                        const std::vector<int>& initialSetupTimes,
+                        const std::vector<int>& minIncoming,
+                        std::vector<SearchTask>& tasks)
+{
+    const int n = orders.size();
+    const int last = prefix.empty() ? -1 : prefix.back();
+    for (int task = 0; task < n; ++task)
+    {
+        if (scheduled[task]) continue;
+        const int setupTime = last >= 0 ? setupTimes[last][task] : initialSetupTimes[task];
+        const long long nextTime = time + setupTime + orders[task].processingTime;
+        const double nextCost = cost + (nextTime > orders[task].dueTime ? orders[task].penaltyRate * (nextTime - orders[task].dueTime) : 0.0);
+
+        scheduled[task] = 1;
+        prefix.push_back(task);
+        const double bound = nextCost + remainingPenaltyBound(scheduled, nextTime, task, orders, setupTimes,
+                                                              initialSetupTimes, minIncoming);
+        if (bound < upperBound)
+        {
+            if (static_cast<int>(prefix.size()) >= splitDepth || static_cast<int>(prefix.size()) == n)
+            {
+                tasks.push_back(SearchTask{prefix, bound});
+            }
+            else
+            {
+                collectSearchTasks(prefix, scheduled, nextTime, nextCost, splitDepth, upperBound, orders,
+                                   setupTimes, initialSetupTimes, minIncoming, tasks);
+            }
+        }
+        prefix.pop_back();
+        scheduled[task] = 0;
+    }
+}
+
+} // namespace
+
+/**
+ * Solves the instance to optimality with a dynamic program over (job set, last job)
+ * states. Because completion times depend on the path, every state keeps the
+ * Pareto front of (completion time, penalty) labels. Labels whose penalty plus the
+ * remaining-jobs bound reaches the incumbent are discarded.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param incumbentSchedule  Known schedule used as the initial upper bound (may be empty).
+ * @param timeLimitSeconds   Wall-clock limit after which the incumbent is returned unproven.
+ * @return                   The optimal schedule, or the incumbent if the limit was hit.
+ */
+ExactResult dynamicProgrammingSolve(const std::vector<Order>& orders,
+                                    const SetupTimes& setupTimes,
+                                    const std::vector<int>& initialSetupTimes,
+                                    const std::vector<int>& incumbentSchedule,
+                                    double timeLimitSeconds)
+{
+    const int n = orders.size();
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                             std::chrono::duration<double>(timeLimitSeconds));
+    const std::vector<int> minIncoming = computeMinIncomingSetups(setupTimes);
+
+    ExactResult result;
+    result.schedule = incumbentSchedule;
+    result.penalty = incumbentPenalty(incumbentSchedule, orders, setupTimes, initialSetupTimes);
+    result.provenOptimal = false;
+    result.nodesExplored = 0;
+
+    std::vector<char> scheduled(n, 0);
+    const double rootBound = computeLowerBound(orders, setupTimes, initialSetupTimes);
+    result.lowerBound = std::min(rootBound, result.penalty);
+    if (n == 0)
+    {
+        result.penalty = 0.0;
+        result.lowerBound = 0.0;
+        result.provenOptimal = true;
+        return result;
+    }
+
+    double upperBound = result.penalty;
+    std::vector<Label> arena;
+    // Layer k maps (job set, last job) to the indices of its non-dominated labels
+    std::unordered_map<uint64_t, std::vector<int>> layer;
+
+    auto stateKey = [n](uint64_t mask, int task) { return mask * n + task; };
+
+    auto insertLabel = [&](std::unordered_map<uint64_t, std::vector<int>>& target, uint64_t key, const Label& label) {
+        std::vector<int>& front = target[key];
+        for (int index : front)
+        {
+            if (arena[index].time <= label.time && arena[index].cost <= label.cost) return;
+        }
+        front.erase(std::remove_if(front.begin(), front.end(),
+                                   [&](int index) {
+                                       return arena[index].time >= label.time && arena[index].cost >= label.cost;
+                                   }),
+                    front.end());
+        front.push_back(arena.size());
+        arena.push_back(label);
+    };
+
+    for (int task = 0; task < n; ++task)
+    {
+        const long long time = initialSetupTimes[task] + orders[task].processingTime;
+        const double cost = time > orders[task].dueTime ? orders[task].penaltyRate * (time - orders[task].dueTime) : 0.0;
+        insertLabel(layer, stateKey(uint64_t{1} << task, task), Label{time, cost, task, -1});
+    }
+
+    for (int size = 1; size < n && !layer.empty(); ++size)
+    {
+        std::unordered_map<uint64_t, std::vector<int>> nextLayer;
+        for (const auto& [key, front] : layer)
+        {
+            if (Clock::now() > deadline) return result;
+
+            const uint64_t mask = key / n;
+            for (int j = 0; j < n; ++j) scheduled[j] = (mask >> j) & 1;
+
+            for (int index : front)
+            {
+                const Label label = arena[index];
+                for (int task = 0; task < n; ++task)
+                {
+                    if (scheduled[task]) continue;
+                    const long long time = label.time + setupTimes[label.task][task] + orders[task].processingTime;
+                    const double cost = label.cost + (time > orders[task].dueTime ? orders[task].penaltyRate * (time - orders[task].dueTime) : 0.0);
+                    if (cost >= upperBound) continue;
+
+                    scheduled[task] = 1;
+                    const double bound = cost + remainingPenaltyBound(scheduled, time, task, orders, setupTimes,
+                                                                      initialSetupTimes, minIncoming);
+                    scheduled[task] = 0;
+                    if (bound >= upperBound) continue;
+
+                    ++result.nodesExplored;
+                    insertLabel(nextLayer, stateKey(mask | (uint64_t{1} << task), task), Label{time, cost, task, index});
+                }
+            }
+        }
+        layer = std::move(nextLayer);
+    }
+
+    // The last layer holds complete sequences; pick the cheapest one
+    int bestIndex = -1;
+    for (const auto& [key, front] : layer)
+    {
+        for (int index : front)
+        {
+            if (arena[index].cost < upperBound)
+            {
+                upperBound = arena[index].cost;
+                bestIndex = index;
+            }
+        }
+    }
+
+    if (bestIndex >= 0)
+    {
+        std::vector<int> schedule;
+        for (int index = bestIndex; index >= 0; index = arena[index].parent)
+        {
+            schedule.push_back(arena[index].task);
+        }
+        std::reverse(schedule.begin(), schedule.end());
+        result.schedule = schedule;
+        result.penalty = upperBound;
+    }
+
+    result.lowerBound = result.penalty;
+    result.provenOptimal = true;
+    return result;
+}
+
+/**
+ * Solves the instance with a depth-first branch-and-bound seeded by the incumbent.
+ * Nodes are pruned by a tardiness lower bound, by the adjacent pairwise interchange
+ * rule and by (job set, last job) dominance against already expanded nodes. The
+ * prefixes at EXACT_PARALLEL_SPLIT_DEPTH are explored in parallel, best bound first.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param incumbentSchedule  Known schedule used as the initial upper bound (may be empty).
+ * @param timeLimitSeconds   Wall-clock limit after which the search stops unproven.
+ * @param numThreads         Worker threads (0 uses all hardware threads).
+ * @param numa               Optional NUMA placement: pins the workers and hands them their node's replica.
+ * @return                   Best schedule found together with the proven lower bound.
+ */
+ExactResult branchAndBoundSolve(const std::vector<Order>& orders,
+                                const SetupTimes& setupTimes,
+                                const std::vector<int>& initialSetupTimes,
+                                const std::vector<int>& incumbentSchedule,
+                                double timeLimitSeconds,
+                                int numThreads,
+                                const NumaContext* numa)
+{
+    const int n = orders.size();
+    const std::vector<int> minIncoming = computeMinIncomingSetups(setupTimes);
+
+    SharedSearchState shared;
+    shared.deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                         std::chrono::duration<double>(timeLimitSeconds));
+    shared.upperBound.store(incumbentPenalty(incumbentSchedule, orders, setupTimes, initialSetupTimes));
+    shared.bestSchedule = incumbentSchedule;
+
+    std::vector<char> scheduled(n, 0);
+    const double rootBound = computeLowerBound(orders, setupTimes, initialSetupTimes);
+
+    std::vector<SearchTask> tasks;
+    std::vector<int> prefix;
+    if (n > 0)
+    {
+        collectSearchTasks(prefix, scheduled, 0, 0.0, EXACT_PARALLEL_SPLIT_DEPTH, shared.upperBound.load(),
+                           orders, setupTimes, initialSetupTimes, minIncoming, tasks);
+    }
+    std::sort(tasks.begin(), tasks.end(),
+              [](const SearchTask& a, const SearchTask& b) { return a.bound < b.bound; });
+
+    if (numThreads <= 0)
+    {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(1, std::min<int>(numThreads, tasks.size()));
+
+    std::vector<char> completed(tasks.size(), 0);
+    std::unique_ptr<NumaThroughput> throughput;
+    if (numa != nullptr)
+    {
+        throughput = std::make_unique<NumaThroughput>(numa->topology());
+    }
+    auto runWorker = [&](int workerIndex) {
+        PROFILE_SCOPE("branch_and_bound");
+        // Pinned workers read the instance (and a private copy of the bound data) from their own node
+        const int node = numa != nullptr ? numa->nodeForWorker(workerIndex) : 0;
+        if (numa != nullptr) numa->pinWorker(workerIndex);
+        const std::vector<int> localMinIncoming = minIncoming;
+        BranchAndBoundWorker worker(numa != nullptr ? numa->orders(node) : orders,
+                                    numa != nullptr ? numa->setupTimes(node) : setupTimes,
+                                    numa != nullptr ? numa->initialSetupTimes(node) : initialSetupTimes,
+                                    localMinIncoming, shared);
+        for (size_t index = shared.nextTask.fetch_add(1); index < tasks.size(); index = shared.nextTask.fetch_add(1))
+        {
+            if (tasks[index].bound >= shared.upperBound.load())
+            {
+                completed[index] = 1;
+                continue;
+            }
+            completed[index] = worker.explore(tasks[index].prefix);
+        }
+        if (throughput) throughput->addWorker(node, worker.nodesVisited());
+    };
+
+    // With NUMA placement every worker gets its own thread so the caller's affinity is left alone
+    const auto start = Clock::now();
+    const int firstSpawned = numa != nullptr ? 0 : 1;
+    std::vector<std::thread> workers;
+    for (int t = firstSpawned; t < numThreads; ++t)
+    {
+        workers.emplace_back(runWorker, t);
+    }
+    if (numa == nullptr)
+    {
+        runWorker(0);
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    if (throughput)
+    {
+        throughput->print("BRANCH_AND_BOUND", "nodes", std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    ExactResult result;
+    result.schedule = shared.bestSchedule;
+    result.penalty = n > 0 ? shared.upperBound.load() : 0.0;
+    result.nodesExplored = shared.nodesExplored.load();
+    result.provenOptimal = !shared.timedOut.load();
+
+    // Subtrees that were not finished still hold the optimum only above their own bound
+    double lowerBound = result.penalty;
+    for (size_t index = 0; index < tasks.size(); ++index)
+    {
+        if (!completed[index])
+        {
+            lowerBound = std::min(lowerBound, tasks[index].bound);
+        }
+    }
+    result.lowerBound = std::max(std::min(rootBound, result.penalty), lowerBound);
+    return result;
+}
+
+/**
+ * Solves the instance exactly with the method that suits its size.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param incumbentSchedule  Known schedule used as the initial upper bound (may be empty).
+ * @param timeLimitSeconds   Wall-clock limit for the search.
+ * @param numThreads         Worker threads for branch-and-bound (0 uses all hardware threads).
+ * @param numa               Optional NUMA placement for the branch-and-bound workers.
+ * @return                   Result of the exact search.
+ */
+ExactResult solveExact(const std::vector<Order>& orders,
+                       const SetupTimes& setupTimes,
+                       const std::vector<int>& initialSetupTimes,
+                       const std::vector<int>& incumbentSchedule,
+                       double timeLimitSeconds,
+                       int numThreads,
+                       const NumaContext* numa)
+{
+    PROFILE_SCOPE("exact");
+    if (static_cast<int>(orders.size()) <= EXACT_DP_MAX_ORDERS)
+    {
+        return dynamicProgrammingSolve(orders, setupTimes, initialSetupTimes, incumbentSchedule, timeLimitSeconds);
+    }
+    return branchAndBoundSolve(orders, setupTimes, initialSetupTimes, incumbentSchedule, timeLimitSeconds, numThreads, numa);
+}
@@ -0,0 +1,419 @@
+// island.cpp
+
+#include "island.h"
+#include "profiler.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Slots live in memory shared between processes, so their counters must not fall back to a lock
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Elite board needs lock-free 64-bit atomics");
+static_assert(std::atomic<std::int32_t>::is_always_lock_free, "Elite board needs lock-free 32-bit atomics");
+
+namespace {
+
+constexpr std::size_t CACHE_LINE_BYTES = 64;
+
+std::size_t roundToCacheLine(std::size_t bytes)
+{
+    return (bytes + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+}
+
+std::runtime_error systemError(const std::string& what, const std::string& name)
+{
+    return std::runtime_error(what + " '" + name + "': " + std::strerror(errno));
+}
+
+// Slots live in shared memory, so a schedule read from one is checked before it is indexed with
+bool isPermutation(const std::vector<int>& schedule, int numOrders)
+{
+    std::vector<bool> seen(numOrders, false);
+    for (const int job : schedule)
+    {
+        if (job < 0 || job >= numOrders || seen[job]) return false;
+        seen[job] = true;
+    }
+    return static_cast<int>(schedule.size()) == numOrders;
+}
+
+} // namespace
+
+// Zero-initialised by ftruncate; the first island to open the board records its shape and instance
+struct EliteBoard::Header {
+    std::atomic<std::int32_t> numIslands;
+    std::atomic<std::int32_t> numOrders;
+    std::atomic<std::uint64_t> fingerprint;
+    std::atomic<std::int32_t> departed;  // Islands that have closed the board, across processes
+};
+
+// Followed by numOrders job ids; sequence is 0 while empty and odd while a write is in progress
+struct EliteBoard::Slot {
+    std::atomic<std::uint64_t> sequence;
+    double penalty;
+
+    std::int32_t* jobs() { return reinterpret_cast<std::int32_t*>(this + 1); }
+};
+
+MigrationTopology parseMigrationTopology(const std::string& name)
+{
+    if (name == "ring") return MigrationTopology::Ring;
+    if (name == "complete") return MigrationTopology::Complete;
+    if (name == "random") return MigrationTopology::Random;
+    throw std::invalid_argument("Unknown migration topology: " + name);
+}
+
+const char* migrationTopologyName(MigrationTopology topology)
+{
+    switch (topology)
+    {
+        case MigrationTopology::Ring: return "ring";
+        case MigrationTopology::Complete: return "complete";
+        case MigrationTopology::Random: return "random";
+    }
+    return "unknown";
+}
+
+/**
+ * Computes a 64-bit FNV-1a hash of the instance, so that a board left over by a
+ * run on another instance of the same size is not mistaken for this run's.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @return                   The fingerprint, never 0 (0 marks a board without one).
+ */
+std::uint64_t instanceFingerprint(const std::vector<Order>& orders,
+                                  const SetupTimes& setupTimes,
+                                  const std::vector<int>& initialSetupTimes)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::uint64_t value) {
+        for (int byte = 0; byte < 8; ++byte)
+        {
+            hash = (hash ^ ((value >> (8 * byte)) & 0xff)) * 1099511628211ull;
+        }
+    };
+
+    for (const Order& order : orders)
+    {
+        std::uint64_t rateBits;
+        std::memcpy(&rateBits, &order.penaltyRate, sizeof(rateBits));
+        mix(static_cast<std::uint64_t>(order.processingTime));
+        mix(static_cast<std::uint64_t>(order.dueTime));
+        mix(rateBits);
+    }
+    for (const int setup : setupTimes.table()) mix(static_cast<std::uint64_t>(setup));
+    for (const int family : setupTimes.familyMap()) mix(static_cast<std::uint64_t>(family));
+    for (const int setup : initialSetupTimes) mix(static_cast<std::uint64_t>(setup));
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+ * Maps the shared-memory board, creating and sizing it on first use.
+ *
+ * @param name         shm_open name (e.g. "/juice_elite").
+ * @param numIslands   Number of slots.
+ * @param numOrders    Jobs per schedule.
+ * @param fingerprint  instanceFingerprint() of the instance being solved.
+ */
+EliteBoard::EliteBoard(const std::string& name, int numIslands, int numOrders, std::uint64_t fingerprint)
+    : name(name), numIslands(numIslands), numOrders(numOrders),
+      slotBytes(roundToCacheLine(sizeof(Slot) + numOrders * sizeof(std::int32_t))),
+      mappedBytes(roundToCacheLine(sizeof(Header)) + numIslands * slotBytes),
+      mapping(nullptr)
+{
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        throw systemError("Cannot open elite board", name);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw systemError("Cannot stat elite board", name);
+    }
+    // Never resize a board other islands may already have mapped
+    if (info.st_size == 0 && ftruncate(fd, static_cast<off_t>(mappedBytes)) != 0)
+    {
+        close(fd);
+        throw systemError("Cannot size elite board", name);
+    }
+    if (info.st_size != 0 && static_cast<std::size_t>(info.st_size) != mappedBytes)
+    {
+        close(fd);
+        throw std::runtime_error("Elite board '" + name + "' belongs to a run with a different shape");
+    }
+
+    mapping = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw systemError("Cannot map elite board", name);
+    }
+
+    Header* header = static_cast<Header*>(mapping);
+    std::int32_t expectedIslands = 0;
+    std::int32_t expectedOrders = 0;
+    std::uint64_t expectedFingerprint = 0;
+    header->numIslands.compare_exchange_strong(expectedIslands, numIslands);
+    header->numOrders.compare_exchange_strong(expectedOrders, numOrders);
+    header->fingerprint.compare_exchange_strong(expectedFingerprint, fingerprint);
+    if ((expectedIslands != 0 && expectedIslands != numIslands) ||
+        (expectedOrders != 0 && expectedOrders != numOrders))
+    {
+        munmap(mapping, mappedBytes);
+        mapping = nullptr;
+        throw std::runtime_error("Elite board '" + name + "' belongs to a run with a different shape");
+    }
+    if (expectedFingerprint != 0 && expectedFingerprint != fingerprint)
+    {
+        munmap(mapping, mappedBytes);
+        mapping = nullptr;
+        throw std::runtime_error("Elite board '" + name + "' belongs to a run on a different instance");
+    }
+}
+
+EliteBoard::~EliteBoard()
+{
+    if (mapping != nullptr)
+    {
+        // Only once every island of the run has left, so that a slow island that has not
+        // attached yet still finds the others' schedules; crashed runs rely on the launcher
+        Header* header = static_cast<Header*>(mapping);
+        if (header->departed.fetch_add(1, std::memory_order_acq_rel) + 1 == numIslands)
+        {
+            unlink(name);
+        }
+        munmap(mapping, mappedBytes);
+    }
+}
+
+void EliteBoard::unlink(const std::string& name)
+{
+    shm_unlink(name.c_str());
+}
+
+EliteBoard::Slot* EliteBoard::slot(int island) const
+{
+    char* base = static_cast<char*>(mapping) + roundToCacheLine(sizeof(Header));
+    return reinterpret_cast<Slot*>(base + island * slotBytes);
+}
+
+/**
+ * Publishes a schedule to the island's own slot.
+ *
+ * @param island    Slot owned by the caller.
+ * @param schedule  Schedule with numOrders jobs.
+ * @param penalty   Its total penalty.
+ */
+void EliteBoard::publish(int island, const std::vector<int>& schedule, double penalty)
+{
+    Slot* target = slot(island);
+    const std::uint64_t sequence = target->sequence.load(std::memory_order_relaxed);
+
+    target->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    target->penalty = penalty;
+    std::int32_t* jobs = target->jobs();
+    for (int k = 0; k < numOrders; ++k)
+    {
+        jobs[k] = schedule[k];
+    }
+    target->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * Reads another island's slot, retrying while its owner is writing it.
+ *
+ * @param island    Slot to read.
+ * @param schedule  Receives the published schedule.
+ * @param penalty   Receives its penalty.
+ * @return          False if the island has not published anything yet, or if its
+ *                  owner stays mid-write (e.g. it died while publishing).
+ */
+bool EliteBoard::read(int island, std::vector<int>& schedule, double& penalty) const
+{
+    Slot* source = slot(island);
+    schedule.resize(numOrders);
+    for (int attempt = 0; attempt < ELITE_BOARD_READ_RETRIES; ++attempt)
+    {
+        const std::uint64_t before = source->sequence.load(std::memory_order_acquire);
+        if (before == 0)
+        {
+            return false;
+        }
+        if (before % 2 == 1)
+        {
+            std::this_thread::yield();  // Owner is mid-write
+            continue;
+        }
+
+        penalty = source->penalty;
+        const std::int32_t* jobs = source->jobs();
+        for (int k = 0; k < numOrders; ++k)
+        {
+            schedule[k] = jobs[k];
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (source->sequence.load(std::memory_order_relaxed) == before)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Runs one island: GRASP iterations interleaved with migrations through the elite board.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param rng                Random number generator.
+ * @param islandConfig       Island parameters.
+ * @param graspConfig        Lower bound and gap tolerance used for early termination, and ILS threads.
+ * @return                   Best schedule of the island and a summary of the board.
+ */
+IslandResult islandSearch(const std::vector<Order>& orders,
+                          const SetupTimes& setupTimes,
+                          const std::vector<int>& initialSetupTimes,
+                          std::mt19937& rng,
+                          const IslandConfig& islandConfig,
+                          const GraspConfig& graspConfig)
+{
+    const int id = islandConfig.islandId;
+    const int numIslands = islandConfig.numIslands;
+    if (numIslands < 1 || id < 0 || id >= numIslands)
+    {
+        throw std::invalid_argument("Island id must lie in [0, number of islands)");
+    }
+    if (islandConfig.migrationInterval < 1 || islandConfig.epochs < 1)
+    {
+        throw std::invalid_argument("Migration interval and epochs must be positive");
+    }
+
+    EliteBoard board(islandConfig.boardName, numIslands, orders.size(),
+                     instanceFingerprint(orders, setupTimes, initialSetupTimes));
+
+    // Reads another island's schedule and scores it here: the published penalty is never trusted
+    ScheduleData foreign;
+    auto readForeign = [&](int source) {
+        double publishedPenalty = 0.0;
+        if (!board.read(source, foreign.schedule, publishedPenalty) ||
+            !isPermutation(foreign.schedule, orders.size()))
+        {
+            return false;
+        }
+        calculateTotalPenalty(foreign, orders, setupTimes, initialSetupTimes);
+        return true;
+    };
+
+    constexpr int numAlphas = sizeof(ISLAND_ALPHAS) / sizeof(ISLAND_ALPHAS[0]);
+    const double alpha = islandConfig.alpha >= 0.0 ? islandConfig.alpha : ISLAND_ALPHAS[id % numAlphas];
+    const double target = targetPenalty(graspConfig);
+
+    IslandResult result;
+    result.penalty = std::numeric_limits<double>::infinity();
+    result.immigrantsAdopted = 0;
+
+    std::vector<int> immigrant;
+    std::uniform_int_distribution<int> otherIsland(0, std::max(numIslands - 2, 0));
+
+    for (int epoch = 0; epoch < islandConfig.epochs && result.penalty > target; ++epoch)
+    {
+        for (int iter = 0; iter < islandConfig.migrationInterval && result.penalty > target; ++iter)
+        {
+            // The first iteration after a migration continues from the adopted schedule
+            std::vector<int> start = immigrant.empty()
+                ? greedyConstruction(orders, setupTimes, initialSetupTimes, alpha, &rng)
+                : std::move(immigrant);
+            immigrant.clear();
+
+            double penalty = 0.0;
+            std::vector<int> improved = ILS(start, orders, setupTimes, initialSetupTimes, penalty, rng, target,
+                                            nullptr, graspConfig.ilsThreads);
+            if (penalty < result.penalty)
+            {
+                result.schedule = std::move(improved);
+                result.penalty = penalty;
+            }
+        }
+
+        PROFILE_SCOPE("migration");
+        board.publish(id, result.schedule, result.penalty);
+        if (numIslands == 1)
+        {
+            continue;
+        }
+
+        // Islands the topology lets this island pull from
+        std::vector<int> sources;
+        switch (islandConfig.topology)
+        {
+            case MigrationTopology::Ring:
+                sources.push_back((id + numIslands - 1) % numIslands);
+                break;
+            case MigrationTopology::Complete:
+                for (int other = 0; other < numIslands; ++other)
+                {
+                    if (other != id) sources.push_back(other);
+                }
+                break;
+            case MigrationTopology::Random:
+            {
+                const int other = otherIsland(rng);
+                sources.push_back(other < id ? other : other + 1);
+                break;
+            }
+        }
+
+        int donor = -1;
+        double donorPenalty = result.penalty;
+        for (const int source : sources)
+        {
+            if (readForeign(source) && foreign.totalPenalty < donorPenalty)
+            {
+                immigrant = foreign.schedule;
+                donor = source;
+                donorPenalty = foreign.totalPenalty;
+            }
+        }
+
+        std::cout << "Island " << id << " epoch " << epoch + 1 << ": penalty " << result.penalty;
+        if (donor >= 0)
+        {
+            std::cout << ", adopted " << donorPenalty << " from island " << donor;
+            result.schedule = immigrant;
+            result.penalty = donorPenalty;
+            ++result.immigrantsAdopted;
+        }
+        std::cout << std::endl;
+    }
+
+    board.publish(id, result.schedule, result.penalty);
+
+    // Summary of the whole board, for runs that only look at one island's output
+    result.boardBestPenalty = result.penalty;
+    result.boardBestIsland = id;
+    for (int other = 0; other < numIslands; ++other)
+    {
+        if (other != id && readForeign(other) && foreign.totalPenalty < result.boardBestPenalty)
+        {
+            result.boardBestPenalty = foreign.totalPenalty;
+            result.boardBestIsland = other;
+        }
+    }
+    return result;
+}
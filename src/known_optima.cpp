@@ -0,0 +1,23 @@
+// known_optima.cpp
+
+#include "known_optima.h"
+
+// Map of optimal penalties for each instance
+const std::unordered_map<std::string, double> optimalPenalties = {
+        {"n60A", 453},
+        {"n60B", 1757},
+        {"n60C", 0},
+        {"n60D", 69102},
+        {"n60E", 58935},
+        {"n60F", 93045},
+        {"n60G", 64632},
+        {"n60H", 145007},
+        {"n60I", 43286},
+        {"n60J", 53555},
+        {"n60K", 458752},
+        {"n60L", 332941},
+        {"n60M", 516926},
+        {"n60N", 492572},
+        {"n60O", 527459},
+        {"n60P", 396183}
+};
@@ -0,0 +1,246 @@
+// lower_bound.cpp
+
+#include "lower_bound.h"
+#include "profiler.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+/**
+ * Solves the square assignment problem min sum cost[i][assignment[i]] with the
+ * Hungarian method (O(n^3)) and returns the optimal value.
+ */
+double solveAssignment(const std::vector<std::vector<double>>& cost)
+{
+    const int n = cost.size();
+    const double inf = std::numeric_limits<double>::infinity();
+    // 1-based potentials and matching as in the classic shortest augmenting path formulation
+    std::vector<double> u(n + 1, 0.0), v(n + 1, 0.0);
+    std::vector<int> matchedRow(n + 1, 0), way(n + 1, 0);
+
+    for (int row = 1; row <= n; ++row)
+    {
+        matchedRow[0] = row;
+        int column = 0;
+        std::vector<double> minSlack(n + 1, inf);
+        std::vector<char> used(n + 1, 0);
+        do
+        {
+            used[column] = 1;
+            const int currentRow = matchedRow[column];
+            double delta = inf;
+            int nextColumn = 0;
+            for (int j = 1; j <= n; ++j)
+            {
+                if (used[j]) continue;
+                const double reduced = cost[currentRow - 1][j - 1] - u[currentRow] - v[j];
+                if (reduced < minSlack[j])
+                {
+                    minSlack[j] = reduced;
+                    way[j] = column;
+                }
+                if (minSlack[j] < delta)
+                {
+                    delta = minSlack[j];
+                    nextColumn = j;
+                }
+            }
+            for (int j = 0; j <= n; ++j)
+            {
+                if (used[j])
+                {
+                    u[matchedRow[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                {
+                    minSlack[j] -= delta;
+                }
+            }
+            column = nextColumn;
+        } while (matchedRow[column] != 0);
+
+        do
+        {
+            const int previous = way[column];
+            matchedRow[column] = matchedRow[previous];
+            column = previous;
+        } while (column != 0);
+    }
+
+    double total = 0.0;
+    for (int j = 1; j <= n; ++j)
+    {
+        total += cost[matchedRow[j] - 1][j - 1];
+    }
+    return total;
+}
+
+/**
+ * Assignment relaxation: with every job shortened to its processing time plus
+ * its cheapest possible setup, the job in position k cannot finish before the
+ * sum of the k smallest shortened durations. Assigning jobs to positions at
+ * those completion times never costs more than any real schedule.
+ */
+double assignmentLowerBound(const std::vector<Order>& orders,
+                            const std::vector<int>& initialSetupTimes,
+                            const std::vector<int>& minIncoming)
+{
+    const int n = orders.size();
+    std::vector<long long> durations(n);
+    for (int j = 0; j < n; ++j)
+    {
+        durations[j] = orders[j].processingTime + std::min(initialSetupTimes[j], minIncoming[j]);
+    }
+
+    std::vector<long long> positionCompletion(durations);
+    std::sort(positionCompletion.begin(), positionCompletion.end());
+    for (int k = 1; k < n; ++k)
+    {
+        positionCompletion[k] += positionCompletion[k - 1];
+    }
+
+    std::vector<std::vector<double>> cost(n, std::vector<double>(n, 0.0));
+    for (int j = 0; j < n; ++j)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            const long long lateness = positionCompletion[k] - orders[j].dueTime;
+            cost[j][k] = lateness > 0 ? orders[j].penaltyRate * lateness : 0.0;
+        }
+    }
+    return solveAssignment(cost);
+}
+
+} // namespace
+
+/**
+ * Computes the cheapest incoming setup of every job over all possible predecessors.
+ *
+ * @param setupTimes  Matrix of setup times between tasks.
+ * @return            Minimum setup time into each job from another job.
+ */
+std::vector<int> computeMinIncomingSetups(const SetupTimes& setupTimes)
+{
+    const int n = setupTimes.size();
+    std::vector<int> minIncoming(n, 0);
+    if (setupTimes.clustered())
+    {
+        // Only families matter: the best predecessor family of g must hold an order other than j itself
+        const int numFamilies = setupTimes.numFamilies();
+        std::vector<int> familySize(numFamilies, 0);
+        for (int j = 0; j < n; ++j) ++familySize[setupTimes.family(j)];
+        std::vector<int> minIntoFamily(numFamilies, 0);
+        for (int g = 0; g < numFamilies; ++g)
+        {
+            int best = std::numeric_limits<int>::max();
+            for (int f = 0; f < numFamilies; ++f)
+            {
+                if (familySize[f] >= (f == g ? 2 : 1))
+                {
+                    best = std::min(best, setupTimes.entry(f, g));
+                }
+            }
+            minIntoFamily[g] = n > 1 ? best : 0;
+        }
+        for (int j = 0; j < n; ++j) minIncoming[j] = minIntoFamily[setupTimes.family(j)];
+        return minIncoming;
+    }
+    for (int j = 0; j < n; ++j)
+    {
+        int best = std::numeric_limits<int>::max();
+        for (int i = 0; i < n; ++i)
+        {
+            if (i != j)
+            {
+                best = std::min(best, setupTimes[i][j]);
+            }
+        }
+        minIncoming[j] = n > 1 ? best : 0;
+    }
+    return minIncoming;
+}
+
+/**
+ * Bounds the penalty of the unscheduled jobs. Every job needs at least its
+ * processing time plus its cheapest incoming setup, so it cannot finish before
+ * currentTime + that amount. On top of that, some job has to finish last, at or
+ * after the sum of all those amounts.
+ *
+ * @param scheduled          Flags of the jobs that are already sequenced.
+ * @param currentTime        Completion time of the sequenced jobs.
+ * @param lastTask           Last sequenced job, or -1 if none.
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param minIncoming        Result of computeMinIncomingSetups.
+ * @return                   Lower bound on the remaining penalty.
+ */
+double remainingPenaltyBound(const std::vector<char>& scheduled, long long currentTime, int lastTask,
+                             const std::vector<Order>& orders,
+                             const SetupTimes& setupTimes,
+                             const std::vector<int>& initialSetupTimes,
+                             const std::vector<int>& minIncoming)
+{
+    const int n = orders.size();
+    double bound = 0.0;
+    long long totalDuration = 0;
+    double bestLastIncrement = std::numeric_limits<double>::infinity();
+
+    for (int j = 0; j < n; ++j)
+    {
+        if (scheduled[j]) continue;
+        const int entrySetup = lastTask >= 0 ? setupTimes[lastTask][j] : initialSetupTimes[j];
+        const long long duration = orders[j].processingTime + std::min(entrySetup, minIncoming[j]);
+        totalDuration += duration;
+        const long long earliest = currentTime + duration;
+        bound += earliest > orders[j].dueTime ? orders[j].penaltyRate * (earliest - orders[j].dueTime) : 0.0;
+    }
+
+    const long long makespan = currentTime + totalDuration;
+    for (int j = 0; j < n; ++j)
+    {
+        if (scheduled[j]) continue;
+        const int entrySetup = lastTask >= 0 ? setupTimes[lastTask][j] : initialSetupTimes[j];
+        const long long earliest = currentTime + orders[j].processingTime + std::min(entrySetup, minIncoming[j]);
+        const double jobBound = earliest > orders[j].dueTime ? orders[j].penaltyRate * (earliest - orders[j].dueTime) : 0.0;
+        const double lastBound = makespan > orders[j].dueTime ? orders[j].penaltyRate * (makespan - orders[j].dueTime) : 0.0;
+        bestLastIncrement = std::min(bestLastIncrement, lastBound - jobBound);
+    }
+
+    if (bestLastIncrement != std::numeric_limits<double>::infinity())
+    {
+        bound += bestLastIncrement;
+    }
+    return bound;
+}
+
+/**
+ * Computes a lower bound on the optimal penalty from setup-time relaxations:
+ * the stronger of the per-job bound and, for instances that are small enough,
+ * the assignment relaxation.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @return                   Lower bound on the optimal total penalty.
+ */
+double computeLowerBound(const std::vector<Order>& orders,
+                         const SetupTimes& setupTimes,
+                         const std::vector<int>& initialSetupTimes)
+{
+    PROFILE_SCOPE("lower_bound");
+    const int n = orders.size();
+    if (n == 0) return 0.0;
+
+    const std::vector<int> minIncoming = computeMinIncomingSetups(setupTimes);
+    const std::vector<char> scheduled(n, 0);
+    double bound = remainingPenaltyBound(scheduled, 0, -1, orders, setupTimes, initialSetupTimes, minIncoming);
+
+    if (n <= LOWER_BOUND_ASSIGNMENT_MAX_ORDERS)
+    {
+        bound = std::max(bound, assignmentLowerBound(orders, initialSetupTimes, minIncoming));
+    }
+    return bound;
+}
@@ -5,43 +5,236 @@
 #include "algorithm.h"
 #include "parser.h"
 #include "schedule_data.h"
+#include "exact_solver.h"
+#include "lower_bound.h"
+#include "island.h"
+#include "rolling_horizon.h"
+#include "numa.h"
+#include "profiler.h"
+#include "known_optima.h"
 #include <random>
 #include <chrono>
 #include <string>
+#include <algorithm>
+#include <limits>
+#include <memory>
 
 namespace fs = std::filesystem;
 
-// Map of optimal penalties for each instance
-std::unordered_map<std::string, double> optimalPenalties = {
-        {"n60A", 453},
-        {"n60B", 1757},
-        {"n60C", 0},
-        {"n60D", 69102},
-        {"n60E", 58935},
-        {"n60F", 93045},
-        {"n60G", 64632},
-        {"n60H", 145007},
-        {"n60I", 43286},
-        {"n60J", 53555},
-        {"n60K", 458752},
-        {"n60L", 332941},
-        {"n60M", 516926},
-        {"n60N", 492572},
-        {"n60O", 527459},
-        {"n60P", 396183}
+struct CommandLineOptions {
+    std::string filepath;
+    bool hasSeed = false;
+    unsigned int seed = 0;
+    bool verifyOptimal = false;
+    double exactTimeLimit = EXACT_TIME_LIMIT_SECONDS;
+    int numThreads = 0;
+    double gapTolerance = 0.0;
+    bool reactiveGrasp = false;
+    double fixedAlpha = 0.25;
+    bool skipDominated = false;
+    int ilsThreads = 1;
+    bool numaPinning = false;
+    bool numaReplicate = false;
+    bool profileCounters = false;
+    std::string profileFoldedPath;
+    int windowSize = 0;  // Rolling-horizon window; 0 decides by instance size
+    bool islandMode = false;
+    IslandConfig islandConfig;
 };
 
-int main(int argc, char *argv[])
+struct HeuristicResult {
+    bool success = false;
+    double penalty = 0.0;
+    double time = 0.0;
+    std::string schedule = "N/A";
+    std::vector<int> rawSchedule;
+};
+
+void printUsage(const char *program)
 {
-    srand(time(NULL));
+    std::cerr << "Usage: " << program << " <instance_file_path> [seed] [options]" << std::endl;
+    std::cerr << "Options:" << std::endl;
+    std::cerr << "  --verify              Run the exact solver even if the optimum is known" << std::endl;
+    std::cerr << "  --exact-time <sec>    Time limit for the exact solver (default " << EXACT_TIME_LIMIT_SECONDS << ")" << std::endl;
+    std::cerr << "  --threads <n>         Worker threads for the exact solver and rolling horizon (default: all cores)" << std::endl;
+    std::cerr << "  --gap <percent>       Stop GRASP once within this gap of the lower bound (default 0)" << std::endl;
+    std::cerr << "  --numa                Pin worker threads to NUMA nodes and report per-node throughput" << std::endl;
+    std::cerr << "  --numa-replicate      Like --numa, with a copy of the instance in every node's memory" << std::endl;
+    std::cerr << "  --profile-counters    Add perf_event hardware counters to the profile (profiler builds)" << std::endl;
+    std::cerr << "  --profile-folded <f>  Write the profile as folded stacks for flamegraph tools (profiler builds)" << std::endl;
+    std::cerr << "  --alpha <a>           Fixed RCL size (default 0.25)" << std::endl;
+    std::cerr << "  --reactive            Pick the RCL size by reactive GRASP instead of a fixed alpha" << std::endl;
+    std::cerr << "  --skip-dominated      Skip ILS on constructions dominated by the elite ones" << std::endl;
+    std::cerr << "  --ils-threads <k>     Evaluate k ILS perturbations concurrently per iteration (default 1)" << std::endl;
+    std::cerr << "  --window <w>          Use rolling-horizon windows of w positions (default from " << ROLLING_HORIZON_MIN_ORDERS << " orders)" << std::endl;
+    std::cerr << "Island model (replaces ILS+GRASP; see run_islands.sh):" << std::endl;
+    std::cerr << "  --islands <n>         Number of cooperating processes" << std::endl;
+    std::cerr << "  --island <id>         Id of this process, in [0, n)" << std::endl;
+    std::cerr << "  --board <name>        Shared-memory elite board (default " << ISLAND_DEFAULT_BOARD << ")" << std::endl;
+    std::cerr << "  --migration-interval <k>  GRASP iterations between migrations (default " << ISLAND_MIGRATION_INTERVAL << ")" << std::endl;
+    std::cerr << "  --epochs <k>          Number of migrations (default " << ISLAND_EPOCHS << ")" << std::endl;
+    std::cerr << "  --topology <name>     ring, complete or random (default ring)" << std::endl;
+}
 
-    if (argc < 2 || argc > 3)
+bool parseCommandLine(int argc, char *argv[], CommandLineOptions &options)
+{
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--verify")
+        {
+            options.verifyOptimal = true;
+        }
+        else if (arg == "--exact-time" && i + 1 < argc)
+        {
+            options.exactTimeLimit = std::stod(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            options.numThreads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--gap" && i + 1 < argc)
+        {
+            options.gapTolerance = std::stod(argv[++i]) / 100.0;
+        }
+        else if (arg == "--numa")
+        {
+            options.numaPinning = true;
+        }
+        else if (arg == "--numa-replicate")
+        {
+            options.numaPinning = true;
+            options.numaReplicate = true;
+        }
+        else if (arg == "--profile-counters")
+        {
+            options.profileCounters = true;
+        }
+        else if (arg == "--profile-folded" && i + 1 < argc)
+        {
+            options.profileFoldedPath = argv[++i];
+        }
+        else if (arg == "--alpha" && i + 1 < argc)
+        {
+            options.fixedAlpha = std::stod(argv[++i]);
+        }
+        else if (arg == "--reactive")
+        {
+            options.reactiveGrasp = true;
+        }
+        else if (arg == "--skip-dominated")
+        {
+            options.skipDominated = true;
+        }
+        else if (arg == "--ils-threads" && i + 1 < argc)
+        {
+            options.ilsThreads = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--window" && i + 1 < argc)
+        {
+            options.windowSize = std::stoi(argv[++i]);
+        }
+        else if (arg == "--islands" && i + 1 < argc)
+        {
+            options.islandMode = true;
+            options.islandConfig.numIslands = std::stoi(argv[++i]);
+        }
+        else if (arg == "--island" && i + 1 < argc)
+        {
+            options.islandMode = true;
+            options.islandConfig.islandId = std::stoi(argv[++i]);
+        }
+        else if (arg == "--board" && i + 1 < argc)
+        {
+            options.islandConfig.boardName = argv[++i];
+        }
+        else if (arg == "--migration-interval" && i + 1 < argc)
+        {
+            options.islandConfig.migrationInterval = std::stoi(argv[++i]);
+        }
+        else if (arg == "--epochs" && i + 1 < argc)
+        {
+            options.islandConfig.epochs = std::stoi(argv[++i]);
+        }
+        else if (arg == "--topology" && i + 1 < argc)
+        {
+            options.islandConfig.topology = parseMigrationTopology(argv[++i]);
+        }
+        else if (arg.rfind("--", 0) == 0)
+        {
+            return false;
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.empty() || positional.size() > 2)
+    {
+        return false;
+    }
+    options.filepath = positional[0];
+    if (positional.size() == 2)
+    {
+        options.hasSeed = true;
+        options.seed = std::stoul(positional[1]);
+    }
+    return true;
+}
+
+// Convert schedule to 1-based indexing for output
+std::string formatSchedule(const std::vector<int> &schedule)
+{
+    std::string formatted;
+    for (size_t j = 0; j < schedule.size(); ++j)
+    {
+        formatted += std::to_string(schedule[j] + 1);
+        if (j != schedule.size() - 1)
+            formatted += ",";
+    }
+    return formatted;
+}
+
+// Relative gap in percent; an optimum of 0 is measured against a unit penalty
+double computeGap(double penalty, double optimalPenalty)
+{
+    return ((penalty - optimalPenalty) / std::max(optimalPenalty, 1.0)) * 100;
+}
+
+void printHeuristicResult(const std::string &prefix, const HeuristicResult &result, double optimalPenalty)
+{
+    std::cout << prefix << "_PENALTY: " << (result.success ? std::to_string(result.penalty) : "N/A") << std::endl;
+    std::cout << prefix << "_TIME: " << (result.success ? std::to_string(result.time) : "N/A") << " seconds" << std::endl;
+    std::cout << prefix << "_GAP: " << (result.success ? std::to_string(computeGap(result.penalty, optimalPenalty)) : "N/A") << "%" << std::endl;
+    std::cout << prefix << "_SCHEDULE: " << (result.success ? result.schedule : "N/A") << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    CommandLineOptions options;
+    try
     {
-        std::cerr << "Usage: " << argv[0] << " <instance_file_path> [seed]" << std::endl;
+        if (!parseCommandLine(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        printUsage(argv[0]);
         return 1;
     }
 
-    std::string filepath = argv[1];
+    if (!PROFILER_ENABLED && (options.profileCounters || !options.profileFoldedPath.empty()))
+    {
+        std::cerr << "Warning: profiler not compiled in (configure with -DJUICE_ENABLE_PROFILER=ON)" << std::endl;
+    }
+    profilerStart(options.profileCounters);
+
+    std::string filepath = options.filepath;
     if (!fs::exists(filepath))
     {
         std::cerr << "Error: File does not exist: " << filepath << std::endl;
@@ -49,7 +242,7 @@ int main(int argc, char *argv[])
     }
 
     std::vector<Order> orders;
-    std::vector<std::vector<int>> setupTimes;
+    SetupTimes setupTimes;
     std::vector<int> initialSetupTimes;
 
     std::string filename = fs::path(filepath).filename().string();
@@ -59,37 +252,33 @@ int main(int argc, char *argv[])
 
     parseInputFile(filepath, orders, setupTimes, initialSetupTimes);
 
-    double optimalPenalty = optimalPenalties[instanceName];
-    if (optimalPenalty <= 0)
+    // Thread placement (and instance replicas) for the threaded phases
+    std::unique_ptr<NumaContext> numa;
+    if (options.numaPinning)
     {
-        std::cerr << "Optimal penalty not defined or invalid for instance: " << instanceName << std::endl;
-        // Output N/A for all metrics
-        std::cout << "CONSTRUCTION_PENALTY: N/A" << std::endl;
-        std::cout << "CONSTRUCTION_TIME: N/A seconds" << std::endl;
-        std::cout << "CONSTRUCTION_GAP: N/A%" << std::endl;
-        std::cout << "CONSTRUCTION_SCHEDULE: N/A" << std::endl;
-
-        std::cout << "RVND_PENALTY: N/A" << std::endl;
-        std::cout << "RVND_TIME: N/A seconds" << std::endl;
-        std::cout << "RVND_GAP: N/A%" << std::endl;
-        std::cout << "RVND_SCHEDULE: N/A" << std::endl;
-
-        std::cout << "ILS_GRASP_PENALTY: N/A" << std::endl;
-        std::cout << "ILS_GRASP_TIME: N/A seconds" << std::endl;
-        std::cout << "ILS_GRASP_GAP: N/A%" << std::endl;
-        std::cout << "ILS_GRASP_SCHEDULE: N/A" << std::endl;
+        numa = std::make_unique<NumaContext>(orders, setupTimes, initialSetupTimes, options.numaReplicate);
+        std::cout << "NUMA_NODES: " << numa->topology().numNodes()
+                  << (numa->replicated() ? " (instance replicated)" : "") << std::endl;
+    }
 
-        std::cout << "OPTIMAL_PENALTY: " << optimalPenalty << std::endl;
-        std::cout << "SEED_USED: N/A" << std::endl;
+    // Lower bound used for early termination and gap reporting
+    auto start_lower_bound = std::chrono::high_resolution_clock::now();
+    const double lowerBound = computeLowerBound(orders, setupTimes, initialSetupTimes);
+    std::chrono::duration<double> elapsed_lower_bound = std::chrono::high_resolution_clock::now() - start_lower_bound;
 
-        return 1;
-    }
+    GraspConfig graspConfig;
+    graspConfig.lowerBound = lowerBound;
+    graspConfig.gapTolerance = options.gapTolerance;
+    graspConfig.reactive = options.reactiveGrasp;
+    graspConfig.fixedAlpha = options.fixedAlpha;
+    graspConfig.skipDominated = options.skipDominated;
+    graspConfig.ilsThreads = options.ilsThreads;
 
     // Initialize random number generator
     unsigned int seed;
-    if (argc == 3)
+    if (options.hasSeed)
     {
-        seed = std::stoul(argv[2]);
+        seed = options.seed;
     }
     else
     {
@@ -98,91 +287,72 @@ int main(int argc, char *argv[])
     }
     std::mt19937 rng(seed);
 
-    // Variables to store metrics
-    double constructionPenalty = 0.0;
-    double rvndPenalty = 0.0;
-    double ils_graspPenalty = 0.0;
-
-    double constructionTime = 0.0;
-    double rvndTime = 0.0;
-    double ils_graspTime = 0.0;
-
-    double constructionGap = 0.0;
-    double rvndGap = 0.0;
-    double ils_graspGap = 0.0;
+    // Large instances (or an explicit --window) run RVND and ILS on rolling-horizon windows
+    const bool rollingHorizon = options.windowSize > 0 || orders.size() >= ROLLING_HORIZON_MIN_ORDERS;
+    RollingHorizonConfig rollingConfig;
+    rollingConfig.windowSize = options.windowSize > 0 ? options.windowSize : ROLLING_HORIZON_WINDOW;
+    rollingConfig.numThreads = options.numThreads;
+    rollingConfig.numa = numa.get();
+    if (rollingHorizon && options.islandMode)
+    {
+        std::cerr << "Error: island mode cannot be combined with the rolling horizon (--window, or from "
+                  << ROLLING_HORIZON_MIN_ORDERS << " orders on)" << std::endl;
+        return 1;
+    }
 
-    std::string best_schedule_construction = "N/A";
-    std::string best_schedule_rvnd = "N/A";
-    std::string best_schedule_ils_grasp = "N/A";
+    HeuristicResult construction;
+    HeuristicResult rvnd;
+    HeuristicResult ils_grasp;
 
     ScheduleData constructionData;  // Declare this outside the try block so it's available globally
 
     // ----------------------------
     // 1. Construction Heuristic
     // ----------------------------
-    bool construction_success = false;
     auto start_construction = std::chrono::high_resolution_clock::now();
     try
     {
         std::vector<int> constructionSchedule = greedyConstruction(orders, setupTimes, initialSetupTimes, 0, nullptr);
         auto end_construction = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> elapsed_construction = end_construction - start_construction;
-        constructionTime = elapsed_construction.count();
+        construction.time = elapsed_construction.count();
 
         constructionData.schedule = constructionSchedule;  // Populate constructionData
         calculateTotalPenalty(constructionData, orders, setupTimes, initialSetupTimes);
-        constructionPenalty = constructionData.totalPenalty;
-        constructionGap = ((constructionPenalty - optimalPenalty) / optimalPenalty) * 100;
-
-        // Convert schedule to 1-based indexing for output
-        best_schedule_construction = "";
-        for (size_t j = 0; j < constructionSchedule.size(); ++j)
-        {
-            best_schedule_construction += std::to_string(constructionSchedule[j] + 1);
-            if (j != constructionSchedule.size() - 1)
-                best_schedule_construction += ",";
-        }
-
-        construction_success = true;
+        construction.penalty = constructionData.totalPenalty;
+        construction.schedule = formatSchedule(constructionSchedule);
+        construction.rawSchedule = constructionSchedule;
+        construction.success = true;
     }
     catch (const std::exception &e)
     {
         std::cerr << "CONSTRUCTION_ERROR: " << e.what() << std::endl;
     }
 
-    // ----------------------------
-    // Output Construction Metrics
-    // ----------------------------
-    std::cout << "CONSTRUCTION_PENALTY: " << (construction_success ? std::to_string(constructionPenalty) : "N/A") << std::endl;
-    std::cout << "CONSTRUCTION_TIME: " << (construction_success ? std::to_string(constructionTime) : "N/A") << " seconds" << std::endl;
-    std::cout << "CONSTRUCTION_GAP: " << (construction_success ? std::to_string(constructionGap) : "N/A") << "%" << std::endl;
-    std::cout << "CONSTRUCTION_SCHEDULE: " << (construction_success ? best_schedule_construction : "N/A") << std::endl;
-
     // ----------------------------
     // 2. RVND Heuristic
     // ----------------------------
-    bool rvnd_success = false;
     auto start_rvnd = std::chrono::high_resolution_clock::now();
     try
     {
-        RVND(constructionData, orders, setupTimes, initialSetupTimes, rng);  // Use constructionData here
-        auto end_rvnd = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed_rvnd = end_rvnd - start_rvnd;
-        rvndTime = elapsed_rvnd.count();
-
-        rvndPenalty = constructionData.totalPenalty;
-        rvndGap = ((rvndPenalty - optimalPenalty) / optimalPenalty) * 100;
-
-        // Convert schedule to 1-based indexing for output
-        best_schedule_rvnd = "";
-        for (size_t j = 0; j < constructionData.schedule.size(); ++j)
+        if (rollingHorizon)
+        {
+            rollingConfig.useILS = false;
+            constructionData.schedule = rollingHorizonSearch(constructionData.schedule, orders, setupTimes, initialSetupTimes,
+                                                             constructionData.totalPenalty, seed, rollingConfig);
+        }
+        else
         {
-            best_schedule_rvnd += std::to_string(constructionData.schedule[j] + 1);
-            if (j != constructionData.schedule.size() - 1)
-                best_schedule_rvnd += ",";
+            RVND(constructionData, orders, setupTimes, initialSetupTimes, rng);  // Use constructionData here
         }
+        auto end_rvnd = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> elapsed_rvnd = end_rvnd - start_rvnd;
+        rvnd.time = elapsed_rvnd.count();
 
-        rvnd_success = true;
+        rvnd.penalty = constructionData.totalPenalty;
+        rvnd.schedule = formatSchedule(constructionData.schedule);
+        rvnd.rawSchedule = constructionData.schedule;
+        rvnd.success = true;
     }
     catch (const std::exception &e)
     {
@@ -190,60 +360,155 @@ int main(int argc, char *argv[])
     }
 
     // ----------------------------
-    // Output RVND Metrics
+    // 3. ILS+GRASP Heuristic (or one island of a multi-process run)
     // ----------------------------
-    std::cout << "RVND_PENALTY: " << (rvnd_success ? std::to_string(rvndPenalty) : "N/A") << std::endl;
-    std::cout << "RVND_TIME: " << (rvnd_success ? std::to_string(rvndTime) : "N/A") << " seconds" << std::endl;
-    std::cout << "RVND_GAP: " << (rvnd_success ? std::to_string(rvndGap) : "N/A") << "%" << std::endl;
-    std::cout << "RVND_SCHEDULE: " << (rvnd_success ? best_schedule_rvnd : "N/A") << std::endl;
-
-    // ----------------------------
-    // 3. ILS+GRASP Heuristic
-    // ----------------------------
-    bool ils_grasp_success = false;
     auto start_ils_grasp = std::chrono::high_resolution_clock::now();
     try
     {
-        std::vector<int> ils_graspSchedule = GRASP(orders, setupTimes, initialSetupTimes, ils_graspPenalty, rng);
+        std::vector<int> ils_graspSchedule;
+        if (rollingHorizon)
+        {
+            rollingConfig.useILS = true;
+            RollingHorizonStats rollingStats;
+            ils_graspSchedule = rollingHorizonSearch(constructionData.schedule, orders, setupTimes, initialSetupTimes,
+                                                     ils_grasp.penalty, seed, rollingConfig, &rollingStats);
+
+            std::cout << "ROLLING_HORIZON_WINDOW: " << rollingConfig.windowSize << std::endl;
+            std::cout << "ROLLING_HORIZON_WINDOWS: " << rollingStats.windowsAccepted << "/" << rollingStats.windowsOptimized
+                      << " improved" << std::endl;
+        }
+        else if (options.islandMode)
+        {
+            const IslandConfig &islandConfig = options.islandConfig;
+            IslandResult island = islandSearch(orders, setupTimes, initialSetupTimes, rng, islandConfig, graspConfig);
+            ils_graspSchedule = island.schedule;
+
+            std::cout << "ISLAND_ID: " << islandConfig.islandId << "/" << islandConfig.numIslands << std::endl;
+            std::cout << "ISLAND_TOPOLOGY: " << migrationTopologyName(islandConfig.topology) << std::endl;
+            std::cout << "ISLAND_IMMIGRANTS: " << island.immigrantsAdopted << std::endl;
+            std::cout << "ISLAND_BOARD_BEST: " << island.boardBestPenalty << " (island " << island.boardBestIsland << ")" << std::endl;
+        }
+        else
+        {
+            ils_graspSchedule = GRASP(orders, setupTimes, initialSetupTimes, ils_grasp.penalty, rng, graspConfig);
+        }
         auto end_ils_grasp = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> elapsed_ils_grasp = end_ils_grasp - start_ils_grasp;
-        ils_graspTime = elapsed_ils_grasp.count();
+        ils_grasp.time = elapsed_ils_grasp.count();
 
         ScheduleData ils_graspData;
         ils_graspData.schedule = ils_graspSchedule;
         calculateTotalPenalty(ils_graspData, orders, setupTimes, initialSetupTimes);
-        ils_graspPenalty = ils_graspData.totalPenalty;
-        ils_graspGap = ((ils_graspPenalty - optimalPenalty) / optimalPenalty) * 100;
+        ils_grasp.penalty = ils_graspData.totalPenalty;
+        ils_grasp.schedule = formatSchedule(ils_graspSchedule);
+        ils_grasp.rawSchedule = ils_graspSchedule;
+        ils_grasp.success = true;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "ILS_GRASP_ERROR: " << e.what() << std::endl;
+    }
+
+    // ----------------------------
+    // 4. Reference (optimal) penalty
+    // ----------------------------
+    // Instances in the table use the published optimum; any other instance
+    // (or --verify) runs the exact solver seeded with the best heuristic schedule.
+    // Rolling-horizon runs are too large for it and report the best schedule found.
+    double optimalPenalty = 0.0;
+    std::string optimalSource = "TABLE";
+    const auto known = optimalPenalties.find(instanceName);
+    if (known != optimalPenalties.end())
+    {
+        optimalPenalty = known->second;
+    }
 
-        // Convert schedule to 1-based indexing for output
-        best_schedule_ils_grasp = "";
-        for (size_t j = 0; j < ils_graspSchedule.size(); ++j)
+    std::vector<int> incumbent;
+    double incumbentPenalty = std::numeric_limits<double>::infinity();
+    for (const HeuristicResult *result : {&construction, &rvnd, &ils_grasp})
+    {
+        if (result->success && result->penalty < incumbentPenalty)
         {
-            best_schedule_ils_grasp += std::to_string(ils_graspSchedule[j] + 1);
-            if (j != ils_graspSchedule.size() - 1)
-                best_schedule_ils_grasp += ",";
+            incumbentPenalty = result->penalty;
+            incumbent = result->rawSchedule;
         }
+    }
 
-        ils_grasp_success = true;
+    if (rollingHorizon && known == optimalPenalties.end() && !options.verifyOptimal)
+    {
+        optimalPenalty = incumbentPenalty;
+        optimalSource = "BEST_KNOWN";
     }
-    catch (const std::exception &e)
+    else if (known == optimalPenalties.end() || options.verifyOptimal)
     {
-        std::cerr << "ILS_GRASP_ERROR: " << e.what() << std::endl;
+
+        auto start_exact = std::chrono::high_resolution_clock::now();
+        try
+        {
+            ExactResult exact = solveExact(orders, setupTimes, initialSetupTimes, incumbent,
+                                           options.exactTimeLimit, options.numThreads, numa.get());
+            std::chrono::duration<double> elapsed_exact = std::chrono::high_resolution_clock::now() - start_exact;
+
+            std::cout << "EXACT_PENALTY: " << exact.penalty << std::endl;
+            std::cout << "EXACT_LOWER_BOUND: " << exact.lowerBound << std::endl;
+            std::cout << "EXACT_STATUS: " << (exact.provenOptimal ? "OPTIMAL" : "TIME_LIMIT") << std::endl;
+            std::cout << "EXACT_NODES: " << exact.nodesExplored << std::endl;
+            std::cout << "EXACT_TIME: " << elapsed_exact.count() << " seconds" << std::endl;
+            std::cout << "EXACT_SCHEDULE: " << formatSchedule(exact.schedule) << std::endl;
+
+            if (known != optimalPenalties.end())
+            {
+                if (!exact.provenOptimal)
+                    std::cout << "EXACT_VERIFIED: UNPROVEN" << std::endl;
+                else
+                    std::cout << "EXACT_VERIFIED: " << (exact.penalty == optimalPenalty ? "MATCH" : "MISMATCH") << std::endl;
+            }
+            else
+            {
+                optimalPenalty = exact.penalty;
+                optimalSource = exact.provenOptimal ? "EXACT" : "BEST_KNOWN";
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "EXACT_ERROR: " << e.what() << std::endl;
+            if (known == optimalPenalties.end())
+            {
+                optimalPenalty = incumbentPenalty;
+                optimalSource = "BEST_KNOWN";
+            }
+        }
     }
 
     // ----------------------------
-    // Output ILS+GRASP Metrics
+    // Output Metrics
     // ----------------------------
-    std::cout << "ILS_GRASP_PENALTY: " << (ils_grasp_success ? std::to_string(ils_graspPenalty) : "N/A") << std::endl;
-    std::cout << "ILS_GRASP_TIME: " << (ils_grasp_success ? std::to_string(ils_graspTime) : "N/A") << " seconds" << std::endl;
-    std::cout << "ILS_GRASP_GAP: " << (ils_grasp_success ? std::to_string(ils_graspGap) : "N/A") << "%" << std::endl;
-    std::cout << "ILS_GRASP_SCHEDULE: " << (ils_grasp_success ? best_schedule_ils_grasp : "N/A") << std::endl;
+    printHeuristicResult("CONSTRUCTION", construction, optimalPenalty);
+    printHeuristicResult("RVND", rvnd, optimalPenalty);
+    printHeuristicResult("ILS_GRASP", ils_grasp, optimalPenalty);
 
     // Output Optimal Penalty
     std::cout << "OPTIMAL_PENALTY: " << optimalPenalty << std::endl;
+    std::cout << "OPTIMAL_SOURCE: " << optimalSource << std::endl;
+
+    // Output Lower Bound and the gap it certifies for the ILS+GRASP schedule; a zero bound certifies none
+    std::cout << "LOWER_BOUND: " << lowerBound << std::endl;
+    std::cout << "LOWER_BOUND_TIME: " << elapsed_lower_bound.count() << " seconds" << std::endl;
+    const bool lowerBoundGap = ils_grasp.success && lowerBound > 0.0;
+    std::cout << "ILS_GRASP_LB_GAP: " << (lowerBoundGap ? std::to_string(computeGap(ils_grasp.penalty, lowerBound)) : "N/A") << "%" << std::endl;
 
     // Print the seed used
     std::cout << "SEED_USED: " << seed << std::endl;
 
+    // Phase profile (profiler builds only)
+    if (PROFILER_ENABLED)
+    {
+        profilerReport(std::cout);
+        if (!options.profileFoldedPath.empty() && !profilerWriteFolded(options.profileFoldedPath))
+        {
+            std::cerr << "Error: cannot write folded profile to " << options.profileFoldedPath << std::endl;
+        }
+    }
+
     return 0;
 }
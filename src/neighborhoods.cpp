@@ -1,54 +1,130 @@
 #include "neighborhoods.h"
+#include "neighborhood_kernels.h"
+#include "compact_schedule.h"
+#include "penalty.h"
+#include "profiler.h"
 #include "algorithm.h"
 #include <algorithm>
+#include <type_traits>
 #include <set>
 #include <iostream>
 #include "schedule_data.h"
 
 
-// swap Neighborhood (Exchanges two blocks or single jobs in the schedule)
-bool swapNeighborhood(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                               const std::vector<std::vector<int>> &setupTimes,
-                               const std::vector<int> &initialSetupTimes) {
-
-    int n = scheduleData.schedule.size();
-    int best_i = -1, best_j = -1, best_l = -1;
-    bool improvementFound = false;
-    double bestPenalty = scheduleData.totalPenalty;
-
-    // Consider block sizes between 2 and 4
-    for (int l = 1; l <= 10; ++l) {
-        for (int i = 0; i <= n - 2 * l; ++i) {
-            for (int j = i + l; j <= n - l; ++j) {
-                ScheduleData tempScheduleData = scheduleData;
-
-                // Perform block exchange in the temporary schedule
-                std::swap_ranges(tempScheduleData.schedule.begin() + i, tempScheduleData.schedule.begin() + i + l,
-                                 tempScheduleData.schedule.begin() + j);
-
-                // Recalculate total penalty for the temporary schedule
-                calculateTotalPenalty(tempScheduleData, orders, setupTimes, initialSetupTimes);
-
-                if (const double newPenalty = tempScheduleData.totalPenalty; newPenalty < bestPenalty) {
-                    bestPenalty = newPenalty;
-                    best_i = i;
-                    best_j = j;
-                    best_l = l;
-                    improvementFound = true;
+namespace {
+
+struct BlockMove {
+    int i;
+    int j;
+    int length;  // -1 when no improving move exists
+    int otherLength = 0;
+};
+
+// Default for findBestMove when a neighborhood has no scan beyond its kernel table
+struct NoExtraScan {
+    template <typename... Args>
+    void operator()(Args&&...) const {}
+};
+
+/**
+ * Runs every kernel of a dispatch table on the schedule, in the penalty type
+ * of the orders (see visitPenaltyType), followed by `extraScan(schedule, timeline, best)`,
+ * and returns the best improving move.
+ */
+template <template <typename, typename> class KernelTable, typename Schedule, typename ExtraScan = NoExtraScan>
+BlockMove findBestMove(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                       const SetupTimes &setupTimes,
+                       const std::vector<int> &initialSetupTimes, ExtraScan extraScan = {})
+{
+    return visitPenaltyType(orders, [&](auto tag) {
+        using Cost = typename decltype(tag)::type;
+        thread_local PrefixTimeline<Cost> timeline;  // Reused across calls to avoid reallocating
+        buildPrefixTimeline(scheduleData.schedule, orders, setupTimes, initialSetupTimes, timeline);
+        MoveCandidate<Cost> best{static_cast<Cost>(scheduleData.totalPenalty)};
+
+        bool batched = false;
+        // The vector lanes accumulate in double, which is exact only for integral penalties
+        if constexpr (std::is_same_v<Cost, IntegerPenalty>) {
+            thread_local BatchEvaluator batch;  // Flattened once per instance and thread, see BatchEvaluator::load
+            batch.load(orders, setupTimes, initialSetupTimes);
+            if (batch.enabled()) {
+                for (const BatchScanKernel<Schedule, Cost> scan : KernelTable<Schedule, Cost>::batchKernels) {
+                    scan(scheduleData.schedule, timeline, batch, best);
                 }
+                batched = true;
             }
         }
-    }
 
-    if (improvementFound) {
+        if (!batched) {
+            for (const ScanKernel<Schedule, Cost> scan : KernelTable<Schedule, Cost>::kernels) {
+                scan(scheduleData.schedule, timeline, orders, setupTimes, initialSetupTimes, best);
+            }
+        }
+        extraScan(scheduleData.schedule, timeline, best);
+        return BlockMove{best.i, best.j, best.length};
+    });
+}
+
+/**
+ * Builds the schedule summary in the penalty type of the orders and
+ * returns the best improving move of `scan(schedule, timeline, summary, best)`.
+ */
+template <typename Schedule, typename SummaryScan>
+BlockMove findBestSummaryMove(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                              const SetupTimes &setupTimes,
+                              const std::vector<int> &initialSetupTimes, SummaryScan scan)
+{
+    return visitPenaltyType(orders, [&](auto tag) {
+        using Cost = typename decltype(tag)::type;
+        thread_local PrefixTimeline<Cost> timeline;  // Reused across calls to avoid reallocating
+        thread_local ScheduleSummary<Cost> summary;
+        buildPrefixTimeline(scheduleData.schedule, orders, setupTimes, initialSetupTimes, timeline);
+        buildScheduleSummary(scheduleData.schedule, orders, setupTimes, initialSetupTimes, summary);
+        MoveCandidate<Cost> best{static_cast<Cost>(scheduleData.totalPenalty)};
+        scan(scheduleData.schedule, timeline, summary, best);
+        return BlockMove{best.i, best.j, best.length, best.otherLength};
+    });
+}
+
+template <typename Schedule, typename Cost>
+struct SwapKernels {
+    static constexpr const auto& kernels = swapScanKernels<Schedule, Cost>;
+    static constexpr const auto& batchKernels = swapBatchKernels<Schedule, Cost>;
+};
+
+template <typename Schedule, typename Cost>
+struct ReinsertionKernels {
+    static constexpr const auto& kernels = reinsertionScanKernels<Schedule, Cost>;
+    static constexpr const auto& batchKernels = reinsertionBatchKernels<Schedule, Cost>;
+};
+
+template <typename Schedule, typename Cost>
+struct ReversalKernels {
+    static constexpr const auto& kernels = reversalScanKernels<Schedule, Cost>;
+    static constexpr const auto& batchKernels = reversalBatchKernels<Schedule, Cost>;
+};
+
+} // namespace
+
+// swap Neighborhood (Exchanges two blocks or single jobs in the schedule)
+template <typename Schedule>
+bool swapNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                               const SetupTimes &setupTimes,
+                               const std::vector<int> &initialSetupTimes) {
+
+    PROFILE_SCOPE("swap");
+    // Consider block sizes between 1 and MAX_BLOCK_LENGTH, each with its own specialized kernel
+    const BlockMove best = findBestMove<SwapKernels>(scheduleData, orders, setupTimes, initialSetupTimes);
+
+    if (best.length > 0) {
         // Apply the best block exchange to the actual schedule
-        std::swap_ranges(scheduleData.schedule.begin() + best_i, scheduleData.schedule.begin() + best_i + best_l,
-                         scheduleData.schedule.begin() + best_j);
+        swapApplyKernels<Schedule>[best.length - 1](scheduleData.schedule, best.i, best.j);
 
         // Recalculate total penalty for the actual schedule
         calculateTotalPenalty(scheduleData, orders, setupTimes, initialSetupTimes);
 
         // Increment the improvement counter
+        ++swap_improvement_count;
         return true;
     }
 
@@ -56,118 +132,127 @@ bool swapNeighborhood(ScheduleData &scheduleData, const std::vector<Order> &orde
 }
 
 // Reinsertion Neighborhood (Shifts a block of jobs, or a single one to another position)
-bool reinsertionNeighborhood(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                            const std::vector<std::vector<int>> &setupTimes,
+template <typename Schedule>
+bool reinsertionNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                            const SetupTimes &setupTimes,
                             const std::vector<int> &initialSetupTimes)
 {
-    int n = scheduleData.schedule.size();
-    int best_i = -1, best_j = -1, best_l = -1;
-    bool improvementFound = false;
-    double bestPenalty = scheduleData.totalPenalty;
+    PROFILE_SCOPE("reinsertion");
+    // Consider block sizes from 1 to MAX_BLOCK_LENGTH, each with its own specialized kernel
+    const BlockMove best = findBestMove<ReinsertionKernels>(scheduleData, orders, setupTimes, initialSetupTimes);
 
-    // Consider block sizes from 1 to 5
-    for (int l = 1; l <= 10; ++l)
-    {
-        for (int i = 0; i <= n - l; ++i)
-        {
-            for (int j = 0; j <= n - l; ++j)
-            {
-                if (j >= i && j <= i + l - 1) continue;  // Skip overlapping positions
-
-                ScheduleData tempScheduleData = scheduleData;
-
-                // Perform block shift in the temporary schedule
-                std::vector<int> block(tempScheduleData.schedule.begin() + i, tempScheduleData.schedule.begin() + i + l);
-                tempScheduleData.schedule.erase(tempScheduleData.schedule.begin() + i, tempScheduleData.schedule.begin() + i + l);
-
-                // Adjust the insertion position if necessary
-                int adjusted_j = j;
-                if (j > i)
-                {
-                    adjusted_j -= l;
-                }
-
-                tempScheduleData.schedule.insert(tempScheduleData.schedule.begin() + adjusted_j, block.begin(), block.end());
-
-                // Recalculate total penalty for the temporary schedule
-                calculateTotalPenalty(tempScheduleData, orders, setupTimes, initialSetupTimes);
-
-                if (const double newPenalty = tempScheduleData.totalPenalty; newPenalty < bestPenalty)
-                {
-                    bestPenalty = newPenalty;
-                    best_i = i;
-                    best_j = j;
-                    best_l = l;
-                    improvementFound = true;
-                }
-            }
-        }
-    }
-
-    if (improvementFound)
+    if (best.length > 0)
     {
         // Apply the best block shift to the actual schedule
-        std::vector<int> block(scheduleData.schedule.begin() + best_i, scheduleData.schedule.begin() + best_i + best_l);
-        scheduleData.schedule.erase(scheduleData.schedule.begin() + best_i, scheduleData.schedule.begin() + best_i + best_l);
-
-        // Adjust the insertion position if necessary
-        int adjusted_j = best_j;
-        if (best_j > best_i)
-        {
-            adjusted_j -= best_l;
-        }
-
-        scheduleData.schedule.insert(scheduleData.schedule.begin() + adjusted_j, block.begin(), block.end());
+        shiftApplyKernels<Schedule>[best.length - 1](scheduleData.schedule, best.i, best.j);
 
         // Recalculate total penalty for the actual schedule
         calculateTotalPenalty(scheduleData, orders, setupTimes, initialSetupTimes);
 
+        ++block_shift_improvement_count;
         return true;
     }
 
     return false;
 }
 
-// 2-Opt Neighborhood (Reverses two segments of the schedule)
-bool twoOptNeighborhood(ScheduleData &scheduleData, const std::vector<Order> &orders,
-                        const std::vector<std::vector<int>> &setupTimes,
+// 2-Opt Neighborhood (Reverses a segment of the schedule, of any length)
+template <typename Schedule>
+bool twoOptNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                        const SetupTimes &setupTimes,
                         const std::vector<int> &initialSetupTimes) {
 
-    int n = scheduleData.schedule.size();
-    int best_i = -1, best_j = -1;
-    bool improvementFound = false;
-    double bestPenalty = scheduleData.totalPenalty;
+    PROFILE_SCOPE("two_opt");
+    // Segment lengths from 2 to MAX_REVERSAL_LENGTH each have their own specialized kernel; longer
+    // segments, up to the whole schedule, are scored in O(log^2 n) from the schedule summary
+    auto longReversals = [&](auto &schedule, const auto &timeline, auto &candidate) {
+        using Cost = decltype(candidate.penalty);
+        if (static_cast<int>(schedule.size()) <= MAX_REVERSAL_LENGTH) return;
+        thread_local ScheduleSummary<Cost> summary;
+        buildScheduleSummary(schedule, orders, setupTimes, initialSetupTimes, summary);
+        scanLongReversals(schedule, timeline, summary, orders, setupTimes, initialSetupTimes, candidate);
+    };
+    const BlockMove best = findBestMove<ReversalKernels>(scheduleData, orders, setupTimes, initialSetupTimes,
+                                                         longReversals);
+
+    if (best.length > 0) {
+        // Apply the best 2-opt move to the actual schedule
+        std::reverse(scheduleData.schedule.begin() + best.i, scheduleData.schedule.begin() + best.j + 1);
 
-    for (int i = 0; i < n - 1; ++i) {
-        // Limit j to ensure the block size does not exceed 10
-        const int max_j = std::min(n - 1, i + 9); // i + 9 ensures block size <= 10
-        for (int j = i + 1; j <= max_j; ++j) {
-            ScheduleData tempScheduleData = scheduleData;
+        // Recalculate total penalty for the actual schedule
+        calculateTotalPenalty(scheduleData, orders, setupTimes, initialSetupTimes);
 
-            // Apply the 2-opt move in the temporary schedule
-            std::reverse(tempScheduleData.schedule.begin() + i, tempScheduleData.schedule.begin() + j + 1);
+        ++two_opt_improvement_count;
+        return true;
+    }
 
-            // Recalculate total penalty for the temporary schedule
-            calculateTotalPenalty(tempScheduleData, orders, setupTimes, initialSetupTimes);
+    return false;
+}
 
-            if (const double newPenalty = tempScheduleData.totalPenalty; newPenalty < bestPenalty) {
-                bestPenalty = newPenalty;
-                best_i = i;
-                best_j = j;
-                improvementFound = true;
-            }
-        }
+// Block Exchange Neighborhood (Exchanges two blocks of different lengths)
+template <typename Schedule>
+bool blockExchangeNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                               const SetupTimes &setupTimes,
+                               const std::vector<int> &initialSetupTimes)
+{
+    PROFILE_SCOPE("block_exchange");
+    const BlockMove best = findBestSummaryMove(
+        scheduleData, orders, setupTimes, initialSetupTimes,
+        [&](auto &schedule, const auto &timeline, const auto &summary, auto &candidate) {
+            scanUnequalBlockExchanges(schedule, timeline, summary, orders, setupTimes, initialSetupTimes, candidate);
+        });
+
+    if (best.length > 0)
+    {
+        exchangeBlocks(scheduleData.schedule, best.i, best.length, best.j, best.otherLength);
+
+        // Recalculate total penalty for the actual schedule
+        calculateTotalPenalty(scheduleData, orders, setupTimes, initialSetupTimes);
+
+        ++block_exchange_improvement_count;
+        return true;
     }
 
-    if (improvementFound) {
-        // Apply the best 2-opt move to the actual schedule
-        std::reverse(scheduleData.schedule.begin() + best_i, scheduleData.schedule.begin() + best_j + 1);
+    return false;
+}
+
+// Or-Opt Neighborhood (Shifts a short block to another position, reversed)
+template <typename Schedule>
+bool orOptNeighborhood(BasicScheduleData<Schedule> &scheduleData, const std::vector<Order> &orders,
+                       const SetupTimes &setupTimes,
+                       const std::vector<int> &initialSetupTimes)
+{
+    PROFILE_SCOPE("or_opt");
+    const BlockMove best = findBestSummaryMove(
+        scheduleData, orders, setupTimes, initialSetupTimes,
+        [&](auto &schedule, const auto &timeline, const auto &summary, auto &candidate) {
+            scanOrOptMoves(schedule, timeline, summary, orders, setupTimes, initialSetupTimes, candidate);
+        });
+
+    if (best.length > 0)
+    {
+        reinsertBlock(scheduleData.schedule, best.i, best.length, best.j, true);
 
         // Recalculate total penalty for the actual schedule
         calculateTotalPenalty(scheduleData, orders, setupTimes, initialSetupTimes);
 
+        ++or_opt_improvement_count;
         return true;
     }
 
     return false;
 }
+
+#define INSTANTIATE_NEIGHBORHOODS(Schedule)                                                             \
+    template bool swapNeighborhood(BasicScheduleData<Schedule>&, const std::vector<Order>&,             \
+                                   const SetupTimes&, const std::vector<int>&);                         \
+    template bool reinsertionNeighborhood(BasicScheduleData<Schedule>&, const std::vector<Order>&,      \
+                                          const SetupTimes&, const std::vector<int>&);                  \
+    template bool twoOptNeighborhood(BasicScheduleData<Schedule>&, const std::vector<Order>&,           \
+                                     const SetupTimes&, const std::vector<int>&);                       \
+    template bool blockExchangeNeighborhood(BasicScheduleData<Schedule>&, const std::vector<Order>&,    \
+                                            const SetupTimes&, const std::vector<int>&);                \
+    template bool orOptNeighborhood(BasicScheduleData<Schedule>&, const std::vector<Order>&,            \
+                                    const SetupTimes&, const std::vector<int>&);
+
+FOR_EACH_SCHEDULE_TYPE(INSTANTIATE_NEIGHBORHOODS)
@@ -0,0 +1,243 @@
+// numa.cpp
+
+#include "numa.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// From <linux/mempolicy.h>; defined here to avoid depending on libnuma headers
+constexpr int NUMA_MPOL_BIND = 2;
+constexpr unsigned NUMA_MPOL_MF_MOVE = 1u << 1;
+constexpr int NUMA_MAX_NODES = 1024;
+
+std::vector<int> allowedCpus()
+{
+    std::vector<int> cpus;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &mask)) cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty())
+    {
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+} // namespace
+
+std::vector<int> parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        if (range.empty() || range == "\n") continue;
+        const size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/**
+ * Reads the node layout from sysfs, keeping only the CPUs this process may use.
+ *
+ * @return  Nodes with at least one usable CPU, ordered by node number.
+ */
+NumaTopology detectNumaTopology()
+{
+    const std::vector<int> allowed = allowedCpus();
+    std::vector<std::pair<int, std::vector<int>>> found;
+
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator("/sys/devices/system/node", error))
+    {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+            !std::all_of(name.begin() + 4, name.end(), ::isdigit))
+        {
+            continue;
+        }
+
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        std::getline(file, list);
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(list))
+        {
+            if (std::binary_search(allowed.begin(), allowed.end(), cpu)) cpus.push_back(cpu);
+        }
+        if (!cpus.empty())
+        {
+            found.emplace_back(std::stoi(name.substr(4)), cpus);
+        }
+    }
+    std::sort(found.begin(), found.end());
+
+    NumaTopology topology;
+    for (auto& [nodeId, cpus] : found)
+    {
+        topology.nodeIds.push_back(nodeId);
+        topology.nodeCpus.push_back(std::move(cpus));
+    }
+    if (topology.nodeCpus.empty())
+    {
+        topology.nodeIds.push_back(0);
+        topology.nodeCpus.push_back(allowed);
+    }
+    return topology;
+}
+
+bool pinCurrentThread(const std::vector<int>& cpus)
+{
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int cpu : cpus)
+    {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &mask);
+    }
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+}
+
+bool bindMemoryToNode(const void* address, std::size_t bytes, int nodeId)
+{
+    if (nodeId < 0 || nodeId >= NUMA_MAX_NODES) return false;
+
+    // mbind works on whole pages; partial pages at the ends may be shared with other allocations
+    const std::uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+    const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(address) + pageSize - 1) / pageSize * pageSize;
+    const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(address) + bytes) / pageSize * pageSize;
+    if (end <= begin) return true;
+
+    unsigned long nodeMask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = {};
+    nodeMask[nodeId / (8 * sizeof(unsigned long))] = 1ul << (nodeId % (8 * sizeof(unsigned long)));
+    return syscall(SYS_mbind, begin, end - begin, NUMA_MPOL_BIND, nodeMask, NUMA_MAX_NODES, NUMA_MPOL_MF_MOVE) == 0;
+}
+
+struct NumaContext::Replica {
+    std::vector<Order> orders;
+    SetupTimes setupTimes;
+    std::vector<int> initialSetupTimes;
+};
+
+/**
+ * Detects the topology and, when asked and there is more than one node,
+ * builds one replica of the instance per node.
+ *
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param replicate          Whether to copy the instance into every node's memory.
+ */
+NumaContext::NumaContext(const std::vector<Order>& orders,
+                         const SetupTimes& setupTimes,
+                         const std::vector<int>& initialSetupTimes,
+                         bool replicate)
+    : nodes(detectNumaTopology()), sourceOrders(orders), sourceSetupTimes(setupTimes),
+      sourceInitialSetupTimes(initialSetupTimes)
+{
+    if (!replicate || nodes.numNodes() < 2)
+    {
+        return;  // A single node already holds the only copy
+    }
+
+    replicas.resize(nodes.numNodes());
+    std::vector<std::thread> builders;
+    for (int node = 0; node < nodes.numNodes(); ++node)
+    {
+        builders.emplace_back([this, node]() {
+            // Allocate and write from the node itself so first touch places the pages there,
+            // then bind them in case the allocator handed back pages touched elsewhere
+            pinCurrentThread(nodes.nodeCpus[node]);
+            auto replica = std::make_unique<Replica>();
+            replica->orders = sourceOrders;
+            replica->setupTimes = sourceSetupTimes;
+            replica->initialSetupTimes = sourceInitialSetupTimes;
+
+            const int nodeId = nodes.nodeIds[node];
+            bindMemoryToNode(replica->orders.data(), replica->orders.size() * sizeof(Order), nodeId);
+            const std::vector<int>& setupTable = replica->setupTimes.table();
+            const std::vector<int>& familyMap = replica->setupTimes.familyMap();
+            bindMemoryToNode(setupTable.data(), setupTable.size() * sizeof(int), nodeId);
+            bindMemoryToNode(familyMap.data(), familyMap.size() * sizeof(int), nodeId);
+            bindMemoryToNode(replica->initialSetupTimes.data(), replica->initialSetupTimes.size() * sizeof(int), nodeId);
+            replicas[node] = std::move(replica);
+        });
+    }
+    for (std::thread& builder : builders)
+    {
+        builder.join();
+    }
+}
+
+NumaContext::~NumaContext() = default;
+
+void NumaContext::pinWorker(int worker) const
+{
+    pinCurrentThread(nodes.nodeCpus[nodeForWorker(worker)]);
+}
+
+const std::vector<Order>& NumaContext::orders(int node) const
+{
+    return replicas.empty() ? sourceOrders : replicas[node]->orders;
+}
+
+const SetupTimes& NumaContext::setupTimes(int node) const
+{
+    return replicas.empty() ? sourceSetupTimes : replicas[node]->setupTimes;
+}
+
+const std::vector<int>& NumaContext::initialSetupTimes(int node) const
+{
+    return replicas.empty() ? sourceInitialSetupTimes : replicas[node]->initialSetupTimes;
+}
+
+NumaThroughput::NumaThroughput(const NumaTopology& topology)
+    : nodeIds(topology.nodeIds), workers(topology.numNodes(), 0), work(topology.numNodes(), 0) {}
+
+void NumaThroughput::addWorker(int node, long long units)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++workers[node];
+    work[node] += units;
+}
+
+/**
+ * Prints the work and rate of every node that ran at least one worker.
+ *
+ * @param phase    Name of the threaded phase (e.g. "ROLLING_HORIZON").
+ * @param unit     Unit of work (e.g. "windows").
+ * @param seconds  Wall-clock duration of the phase.
+ */
+void NumaThroughput::print(const std::string& phase, const std::string& unit, double seconds) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t node = 0; node < work.size(); ++node)
+    {
+        if (workers[node] == 0) continue;
+        const double rate = seconds > 0.0 ? work[node] / seconds : 0.0;
+        std::cout << "NUMA_THROUGHPUT " << phase << " node " << nodeIds[node] << ": " << workers[node] << " workers, "
+                  << work[node] << " " << unit << ", " << std::fixed << std::setprecision(1) << rate
+                  << std::defaultfloat << std::setprecision(6) << " " << unit << "/s" << std::endl;
+    }
+}
@@ -1,14 +1,68 @@
 // parser.cpp
 #include "parser.h"
 #include "order.h"
+#include <cmath>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <utility>
+
+/**
+ * Reads the family-clustered setup section: the family of every order, the
+ * initial setup of every family and the F x F family setup matrix. Initial
+ * setups are expanded to one entry per order, as in the dense format.
+ *
+ * @param file               Stream positioned after the penalty rates' blank line.
+ * @param numOrders          Number of orders.
+ * @param numFamilies        Number of families F.
+ * @param setupTimes         Receives the family setup model.
+ * @param initialSetupTimes  Receives the initial setup time of every order.
+ */
+static void parseFamilySetups(std::ifstream& file, int numOrders, int numFamilies,
+                              SetupTimes& setupTimes, std::vector<int>& initialSetupTimes) {
+    // Read the family of each order (0-based)
+    std::vector<int> familyOf(numOrders);
+    for (int i = 0; i < numOrders; ++i) {
+        if (!(file >> familyOf[i]) || familyOf[i] < 0 || familyOf[i] >= numFamilies) {
+            std::cerr << "Error reading family of job " << i << std::endl;
+            familyOf[i] = 0;
+        }
+    }
+
+    // Read initial family setup times (s0f)
+    std::vector<int> initialFamilySetups(numFamilies);
+    for (int f = 0; f < numFamilies; ++f) {
+        if (!(file >> initialFamilySetups[f]) || initialFamilySetups[f] < 0) {
+            std::cerr << "Error reading initial setup time for family " << f << std::endl;
+            initialFamilySetups[f] = 0;
+        }
+    }
+    initialSetupTimes.resize(numOrders);
+    for (int j = 0; j < numOrders; ++j) {
+        initialSetupTimes[j] = initialFamilySetups[familyOf[j]];
+    }
+
+    // Read family setup times matrix (sfg)
+    setupTimes = SetupTimes(std::move(familyOf), numFamilies);
+    for (int f = 0; f < numFamilies; ++f) {
+        for (int g = 0; g < numFamilies; ++g) {
+            int& setupTime = setupTimes.entry(f, g);
+            if (!(file >> setupTime)) {
+                std::cerr << "Error reading setup time between families " << f << " and " << g << std::endl;
+                setupTime = 0;
+            }
+            if (setupTime < 0) {
+                std::cerr << "Error: Negative setup time between families " << f << " and " << g << std::endl;
+                setupTime = 0;
+            }
+        }
+    }
+}
 
 void parseInputFile(const std::string& filename, std::vector<Order>& orders,
-                    std::vector<std::vector<int>>& setupTimes,
+                    SetupTimes& setupTimes,
                     std::vector<int>& initialSetupTimes) {
     std::ifstream file(filename);
 
@@ -17,12 +71,19 @@ void parseInputFile(const std::string& filename, std::vector<Order>& orders,
         return;
     }
 
-    int numOrders;
-    file >> numOrders;
-
-    // Skip the empty line
+    // Header: "<orders>" for a dense setup matrix, "<orders> <families>" for family-clustered setups
     std::string line;
-    std::getline(file, line); // Move to the next line after numOrders
+    std::getline(file, line);
+    std::istringstream header(line);
+    int numOrders = 0;
+    int numFamilies = 0;
+    header >> numOrders;
+    const bool clustered = static_cast<bool>(header >> numFamilies);
+    if (numOrders < 0 || (clustered && numFamilies <= 0)) {
+        std::cerr << "Error: Invalid header in file: " << filename << std::endl;
+        return;
+    }
+
     std::getline(file, line); // Skip empty line
 
     // Resize orders vector to include all jobs (0-based)
@@ -57,10 +118,21 @@ void parseInputFile(const std::string& filename, std::vector<Order>& orders,
         }
     }
 
+    // Exact integer penalty arithmetic is used when every rate is a whole number (see hasIntegralPenaltyRates)
+    for (int i = 0; i < numOrders; ++i) {
+        orders[i].integerPenaltyRate = std::llround(orders[i].penaltyRate);
+    }
+
     // Skip the empty line before the setup times matrix
     std::getline(file, line);
     std::getline(file, line); // Skip empty line
 
+    if (clustered) {
+        parseFamilySetups(file, numOrders, numFamilies, setupTimes, initialSetupTimes);
+        file.close();
+        return;
+    }
+
     // Read initial setup times (s0j)
     initialSetupTimes.resize(numOrders);
     for (int j = 0; j < numOrders; ++j) {
@@ -71,17 +143,18 @@ void parseInputFile(const std::string& filename, std::vector<Order>& orders,
     }
 
     // Read setup times matrix (sij)
-    setupTimes.resize(numOrders, std::vector<int>(numOrders));
+    setupTimes = SetupTimes(numOrders);
 
     for (int i = 0; i < numOrders; ++i) {
         for (int j = 0; j < numOrders; ++j) {
-            if (!(file >> setupTimes[i][j])) {
+            int& setupTime = setupTimes.entry(i, j);
+            if (!(file >> setupTime)) {
                 std::cerr << "Error reading setup time between jobs " << i << " and " << j << std::endl;
-                setupTimes[i][j] = 0;
+                setupTime = 0;
             }
-            if (setupTimes[i][j] < 0) {
+            if (setupTime < 0) {
                 std::cerr << "Error: Negative setup time between jobs " << i << " and " << j << std::endl;
-                setupTimes[i][j] = 0;
+                setupTime = 0;
             }
         }
     }
@@ -0,0 +1,336 @@
+// profiler.cpp
+
+#include "profiler.h"
+
+#ifdef JUICE_ENABLE_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define JUICE_PROFILER_USE_TSC 1
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t readTicks()
+{
+#ifdef JUICE_PROFILER_USE_TSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct ProfileNode {
+    ProfileNode(const char* name, int parent) : name(name), parent(parent) {}
+
+    const char* name;
+    int parent;
+    long long calls = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t counters[PROFILE_COUNTER_COUNT] = {};
+    std::vector<int> children;
+};
+
+// Call tree and perf counter group of one thread; node 0 is the thread's root
+struct ThreadProfile {
+    std::vector<ProfileNode> nodes;
+    int current = 0;
+    int counterFds[PROFILE_COUNTER_COUNT] = {-1, -1, -1, -1};
+    bool countersOpen = false;
+
+    ~ThreadProfile()
+    {
+        for (int fd : counterFds)
+        {
+            if (fd >= 0) close(fd);
+        }
+    }
+};
+
+struct ProfilerState {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadProfile>> threads;
+    std::atomic<unsigned> generation{0};
+    bool hardwareCounters = false;
+    bool countersAvailable = true;
+    std::thread::id mainThread;
+    std::uint64_t startTicks = readTicks();
+    Clock::time_point startTime = Clock::now();
+};
+
+ProfilerState& profilerState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+int openCounter(std::uint64_t config, int groupFd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    // pid 0, cpu -1: count the calling thread on whatever CPU it runs
+    return syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+// Opens cycles, instructions, LLC misses and branch misses as one group; false if perf is not permitted
+bool openCounters(ThreadProfile& profile)
+{
+    const std::uint64_t configs[PROFILE_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int k = 0; k < PROFILE_COUNTER_COUNT; ++k)
+    {
+        profile.counterFds[k] = openCounter(configs[k], k == 0 ? -1 : profile.counterFds[0]);
+        if (profile.counterFds[k] < 0)
+        {
+            for (int& fd : profile.counterFds)
+            {
+                if (fd >= 0) close(fd);
+                fd = -1;
+            }
+            return false;
+        }
+    }
+    ioctl(profile.counterFds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(profile.counterFds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void readCounters(const ThreadProfile& profile, std::uint64_t* values)
+{
+    if (!profile.countersOpen)
+    {
+        std::fill(values, values + PROFILE_COUNTER_COUNT, 0);
+        return;
+    }
+    std::uint64_t buffer[1 + PROFILE_COUNTER_COUNT] = {};
+    if (read(profile.counterFds[0], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)))
+    {
+        std::fill(values, values + PROFILE_COUNTER_COUNT, 0);
+        return;
+    }
+    std::copy(buffer + 1, buffer + 1 + PROFILE_COUNTER_COUNT, values);
+}
+
+ThreadProfile& threadProfile()
+{
+    thread_local std::shared_ptr<ThreadProfile> profile;
+    thread_local unsigned generation = ~0u;
+
+    ProfilerState& state = profilerState();
+    if (!profile || generation != state.generation.load(std::memory_order_acquire))
+    {
+        // First scope on this thread since profilerStart: register a fresh tree
+        std::lock_guard<std::mutex> lock(state.mutex);
+        profile = std::make_shared<ThreadProfile>();
+        generation = state.generation.load();
+        const bool isMain = std::this_thread::get_id() == state.mainThread;
+        profile->nodes.emplace_back(isMain ? "main" : "worker", -1);
+        if (state.hardwareCounters && state.countersAvailable)
+        {
+            profile->countersOpen = openCounters(*profile);
+            state.countersAvailable = profile->countersOpen;
+        }
+        state.threads.push_back(profile);
+    }
+    return *profile;
+}
+
+int childNode(ThreadProfile& profile, const char* name)
+{
+    const int parent = profile.current;
+    for (int child : profile.nodes[parent].children)
+    {
+        const char* childName = profile.nodes[child].name;
+        if (childName == name || std::strcmp(childName, name) == 0) return child;
+    }
+    profile.nodes.emplace_back(name, parent);
+    const int child = profile.nodes.size() - 1;
+    profile.nodes[parent].children.push_back(child);
+    return child;
+}
+
+struct PhaseTotals {
+    long long calls = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t selfTicks = 0;
+    std::uint64_t counters[PROFILE_COUNTER_COUNT] = {};
+};
+
+std::uint64_t selfTicks(const ThreadProfile& profile, int node)
+{
+    std::uint64_t childTicks = 0;
+    for (int child : profile.nodes[node].children) childTicks += profile.nodes[child].ticks;
+    return profile.nodes[node].ticks > childTicks ? profile.nodes[node].ticks - childTicks : 0;
+}
+
+double ticksPerSecond()
+{
+    const ProfilerState& state = profilerState();
+    const double seconds = std::chrono::duration<double>(Clock::now() - state.startTime).count();
+    return seconds > 0.0 ? (readTicks() - state.startTicks) / seconds : 1.0;
+}
+
+} // namespace
+
+ProfileScope::ProfileScope(const char* name)
+{
+    ThreadProfile& profile = threadProfile();
+    node = childNode(profile, name);
+    profile.current = node;
+    readCounters(profile, startCounters);
+    startTicks = readTicks();
+}
+
+ProfileScope::~ProfileScope()
+{
+    const std::uint64_t endTicks = readTicks();
+    ThreadProfile& profile = threadProfile();
+    std::uint64_t endCounters[PROFILE_COUNTER_COUNT];
+    readCounters(profile, endCounters);
+
+    ProfileNode& entry = profile.nodes[node];
+    ++entry.calls;
+    entry.ticks += endTicks - startTicks;
+    for (int k = 0; k < PROFILE_COUNTER_COUNT; ++k) entry.counters[k] += endCounters[k] - startCounters[k];
+    profile.current = entry.parent;
+}
+
+void profilerStart(bool hardwareCounters)
+{
+    ProfilerState& state = profilerState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.threads.clear();
+    state.hardwareCounters = hardwareCounters;
+    state.countersAvailable = true;
+    state.mainThread = std::this_thread::get_id();
+    state.startTime = Clock::now();
+    state.startTicks = readTicks();
+    ++state.generation;
+}
+
+/**
+ * Writes one row per phase name, merged over every place it occurs and over all threads.
+ *
+ * @param out  Stream receiving the table.
+ */
+void profilerReport(std::ostream& out)
+{
+    ProfilerState& state = profilerState();
+    const double tickRate = ticksPerSecond();
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - state.startTime).count();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::map<std::string, PhaseTotals> phases;
+    bool counters = false;
+    for (const auto& profile : state.threads)
+    {
+        counters = counters || profile->countersOpen;
+        for (size_t node = 1; node < profile->nodes.size(); ++node)
+        {
+            const ProfileNode& entry = profile->nodes[node];
+            PhaseTotals& totals = phases[entry.name];
+            totals.calls += entry.calls;
+            totals.ticks += entry.ticks;
+            totals.selfTicks += selfTicks(*profile, node);
+            for (int k = 0; k < PROFILE_COUNTER_COUNT; ++k) totals.counters[k] += entry.counters[k];
+        }
+    }
+
+    std::vector<std::pair<std::string, PhaseTotals>> rows(phases.begin(), phases.end());
+    std::sort(rows.begin(), rows.end(),
+              [](const auto& a, const auto& b) { return a.second.ticks > b.second.ticks; });
+
+    out << "=============================================" << std::endl;
+    out << "Profile (" << std::fixed << std::setprecision(3) << wallSeconds << " s wall";
+    if (state.hardwareCounters && !counters) out << ", hardware counters unavailable";
+    out << ")" << std::endl;
+    out << std::left << std::setw(24) << "Phase" << std::right << std::setw(12) << "Calls"
+        << std::setw(12) << "Total ms" << std::setw(12) << "Self ms" << std::setw(12) << "Avg us" << std::setw(8) << "%";
+    if (counters)
+    {
+        out << std::setw(16) << "Cycles" << std::setw(8) << "IPC" << std::setw(14) << "LLC miss" << std::setw(14) << "Br miss";
+    }
+    out << std::endl;
+
+    for (const auto& [name, totals] : rows)
+    {
+        const double totalMs = totals.ticks / tickRate * 1e3;
+        out << std::left << std::setw(24) << name << std::right << std::setw(12) << totals.calls
+            << std::setw(12) << std::setprecision(1) << totalMs
+            << std::setw(12) << totals.selfTicks / tickRate * 1e3
+            << std::setw(12) << std::setprecision(2) << (totals.calls > 0 ? totalMs * 1e3 / totals.calls : 0.0)
+            << std::setw(8) << std::setprecision(1) << (wallSeconds > 0.0 ? totalMs / 10.0 / wallSeconds : 0.0);
+        if (counters)
+        {
+            const double ipc = totals.counters[0] > 0 ? static_cast<double>(totals.counters[1]) / totals.counters[0] : 0.0;
+            out << std::setw(16) << totals.counters[0] << std::setw(8) << std::setprecision(2) << ipc
+                << std::setw(14) << totals.counters[2] << std::setw(14) << totals.counters[3];
+        }
+        out << std::endl;
+    }
+    out << "=============================================" << std::endl;
+    out << std::defaultfloat << std::setprecision(6);
+}
+
+/**
+ * Writes the call tree in the folded-stack format read by flamegraph.pl and speedscope.
+ *
+ * @param path  Output file.
+ * @return      False if the file could not be written.
+ */
+bool profilerWriteFolded(const std::string& path)
+{
+    ProfilerState& state = profilerState();
+    const double tickRate = ticksPerSecond();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::map<std::string, std::uint64_t> stacks;
+    for (const auto& profile : state.threads)
+    {
+        std::vector<std::string> paths(profile->nodes.size());
+        paths[0] = profile->nodes[0].name;
+        // Children are always created after their parent, so one forward sweep builds every path
+        for (size_t node = 1; node < profile->nodes.size(); ++node)
+        {
+            paths[node] = paths[profile->nodes[node].parent] + ";" + profile->nodes[node].name;
+            stacks[paths[node]] += selfTicks(*profile, node);
+        }
+    }
+
+    std::ofstream file(path);
+    if (!file) return false;
+    for (const auto& [stack, ticks] : stacks)
+    {
+        const auto microseconds = static_cast<long long>(ticks / tickRate * 1e6);
+        if (microseconds > 0) file << stack << " " << microseconds << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+#endif // JUICE_ENABLE_PROFILER
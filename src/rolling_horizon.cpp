@@ -0,0 +1,318 @@
+// rolling_horizon.cpp
+
+#include "rolling_horizon.h"
+#include "algorithm.h"
+#include "schedule_data.h"
+#include "numa.h"
+#include "profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace {
+
+// Fixed boundary of a window: what precedes it and the job that must not be delayed after it
+struct WindowBoundary {
+    long long startTime;     // Completion time of the job before the window (0 at the start)
+    int predecessor;         // Job before the window, -1 at the start
+    int pinnedJob;           // Job at the window's last position, -1 for the final window
+    long long pinnedCompletion;
+    double suffixTardyWeight;  // Weight of the tardy jobs after the window, delayed one-for-one with the pinned job
+};
+
+/**
+ * Optimizes schedule[start, end) as a sub-instance and writes the new order
+ * back if it is accepted. Only positions of this window are read, and only its
+ * free positions are written: the pinned job at end - 1 never moves, so it is
+ * left untouched for the next window, whose boundary was taken from it before
+ * any window of the phase started.
+ *
+ * The pinned job stays in the sub-instance as a job due at its current
+ * completion time, weighted by everything its delay would make later, and
+ * with prohibitive setups towards the other jobs so that it remains last.
+ *
+ * @return  True if the window was improved.
+ */
+bool optimizeWindow(std::vector<int>& schedule, int start, int end, const WindowBoundary& boundary,
+                    const std::vector<Order>& orders,
+                    const SetupTimes& setupTimes,
+                    const std::vector<int>& initialSetupTimes,
+                    bool useILS, std::mt19937& rng)
+{
+    PROFILE_SCOPE("window");
+    const bool pinned = boundary.pinnedJob >= 0;
+    const int localCount = end - start;
+    const int freeCount = localCount - (pinned ? 1 : 0);
+    if (freeCount < 2)
+    {
+        return false;
+    }
+
+    // Sub-instance over the window: due dates relative to the window start,
+    // initial setups from the fixed predecessor
+    std::vector<Order> localOrders(localCount);
+    std::vector<int> localInitialSetups(localCount);
+    SetupTimes localSetups(localCount);  // Dense, since the pinned job's row differs from its family's
+    long long windowHorizon = 0;
+    visitSetupModel(setupTimes, [&](const auto setups) {
+        for (int k = 0; k < localCount; ++k)
+        {
+            const int job = schedule[start + k];
+            localOrders[k] = orders[job];
+            localOrders[k].id = k;
+            const long long shiftedDue = orders[job].dueTime - boundary.startTime;
+            localOrders[k].dueTime = static_cast<int>(std::max<long long>(shiftedDue, std::numeric_limits<int>::min()));
+            localInitialSetups[k] = boundary.predecessor >= 0 ? setups(boundary.predecessor, job) : initialSetupTimes[job];
+            int maxSetup = localInitialSetups[k];
+            for (int l = 0; l < localCount; ++l)
+            {
+                localSetups.entry(k, l) = setups(job, schedule[start + l]);
+                maxSetup = std::max(maxSetup, localSetups.entry(k, l));
+            }
+            windowHorizon += orders[job].processingTime + maxSetup;
+        }
+    });
+
+    if (pinned)
+    {
+        // Any delay of the pinned job delays every tardy job after the window as well
+        Order& pinnedOrder = localOrders[freeCount];
+        const bool pinnedTardy = boundary.pinnedCompletion > orders[boundary.pinnedJob].dueTime;
+        pinnedOrder.penaltyRate = (pinnedTardy ? orders[boundary.pinnedJob].penaltyRate : 0.0) + boundary.suffixTardyWeight;
+        pinnedOrder.integerPenaltyRate = std::llround(pinnedOrder.penaltyRate);
+        pinnedOrder.dueTime = static_cast<int>(boundary.pinnedCompletion - boundary.startTime);
+
+        // A job placed after the pinned one finishes past the end of the window and past its due date
+        long long maxDue = 0;
+        for (const Order& order : localOrders) maxDue = std::max<long long>(maxDue, order.dueTime);
+        const int prohibitiveSetup = static_cast<int>(std::min<long long>(windowHorizon + maxDue + 1,
+                                                                          std::numeric_limits<int>::max() / (localCount + 1)));
+        for (int l = 0; l < freeCount; ++l)
+        {
+            localSetups.entry(freeCount, l) = prohibitiveSetup;
+        }
+    }
+
+    // True penalty of the window and completion time of its last job, for a local order
+    auto evaluate = [&](const std::vector<int>& local, long long& lastCompletion) {
+        return visitSetupModel(setupTimes, [&](const auto setups) {
+            double penalty = 0.0;
+            long long time = boundary.startTime;
+            for (int k = 0; k < localCount; ++k)
+            {
+                const int job = schedule[start + local[k]];
+                time += (k > 0 ? setups(schedule[start + local[k - 1]], job)
+                               : (boundary.predecessor >= 0 ? setups(boundary.predecessor, job) : initialSetupTimes[job]))
+                        + orders[job].processingTime;
+                penalty += orders[job].penaltyRate * std::max(0LL, time - orders[job].dueTime);
+            }
+            lastCompletion = time;
+            return penalty;
+        });
+    };
+
+    std::vector<int> identity(localCount);
+    for (int k = 0; k < localCount; ++k) identity[k] = k;
+    long long currentCompletion = 0;
+    const double currentPenalty = evaluate(identity, currentCompletion);
+
+    ScheduleData candidate;
+    candidate.schedule = identity;
+    if (useILS)
+    {
+        candidate.schedule = ILS(identity, localOrders, localSetups, localInitialSetups, candidate.totalPenalty, rng);
+    }
+    else
+    {
+        calculateTotalPenalty(candidate, localOrders, localSetups, localInitialSetups);
+        RVND(candidate, localOrders, localSetups, localInitialSetups, rng);
+    }
+
+    if (pinned && candidate.schedule.back() != freeCount)
+    {
+        return false;
+    }
+    long long candidateCompletion = 0;
+    const double candidatePenalty = evaluate(candidate.schedule, candidateCompletion);
+    if (candidatePenalty >= currentPenalty || (pinned && candidateCompletion > currentCompletion))
+    {
+        return false;
+    }
+
+    std::vector<int> jobs(schedule.begin() + start, schedule.begin() + end);
+    for (int k = 0; k < freeCount; ++k)
+    {
+        schedule[start + k] = jobs[candidate.schedule[k]];
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Rolling-horizon improvement of a full schedule; see rolling_horizon.h.
+ *
+ * @param initialSchedule    Schedule to improve.
+ * @param orders             Vector of orders.
+ * @param setupTimes         Matrix of setup times between tasks.
+ * @param initialSetupTimes  Vector of initial setup times.
+ * @param totalPenaltyCost   Reference to store the penalty of the returned schedule.
+ * @param seed               Seed of the per-window random streams.
+ * @param config             Window size, passes, window optimizer and threads.
+ * @param stats              Optional counters of optimized and accepted windows.
+ * @return                   Improved schedule.
+ */
+std::vector<int> rollingHorizonSearch(const std::vector<int>& initialSchedule,
+                                      const std::vector<Order>& orders,
+                                      const SetupTimes& setupTimes,
+                                      const std::vector<int>& initialSetupTimes,
+                                      double& totalPenaltyCost,
+                                      unsigned int seed,
+                                      const RollingHorizonConfig& config,
+                                      RollingHorizonStats* stats)
+{
+    std::vector<int> schedule = initialSchedule;
+    const int n = schedule.size();
+    const int windowSize = std::max(3, std::min(config.windowSize, n));
+    const int numThreads = config.numThreads > 0
+        ? config.numThreads
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<long long> completion(n);
+    std::vector<double> tardyWeightFrom(n + 1);
+    std::atomic<long long> windowsOptimized{0};
+    std::atomic<long long> windowsAccepted{0};
+    std::vector<long long> windowsByWorker(numThreads, 0);  // For the per-NUMA-node throughput
+    const NumaContext* numa = config.numa;
+    const auto searchStart = std::chrono::steady_clock::now();
+
+    for (int pass = 0; pass < config.passes; ++pass)
+    {
+        long long acceptedInPass = 0;
+        for (int phase = 0; phase < 2; ++phase)
+        {
+            // Completion times of the schedule as it stands before this phase, and the
+            // weight of the tardy jobs from each position on
+            visitSetupModel(setupTimes, [&](const auto setups) {
+                long long time = 0;
+                for (int k = 0; k < n; ++k)
+                {
+                    const int job = schedule[k];
+                    time += (k > 0 ? setups(schedule[k - 1], job) : initialSetupTimes[job]) + orders[job].processingTime;
+                    completion[k] = time;
+                }
+            });
+            tardyWeightFrom[n] = 0.0;
+            for (int k = n - 1; k >= 0; --k)
+            {
+                const Order& order = orders[schedule[k]];
+                tardyWeightFrom[k] = tardyWeightFrom[k + 1] + (completion[k] > order.dueTime ? order.penaltyRate : 0.0);
+            }
+
+            std::vector<int> windowStarts;
+            for (int start = phase == 0 ? 0 : windowSize / 2; start < n; start += windowSize)
+            {
+                windowStarts.push_back(start);
+            }
+
+            // Boundaries are taken here, before any worker writes: windows of a phase are disjoint,
+            // but each one's predecessor is the previous window's pinned job
+            std::vector<WindowBoundary> boundaries(windowStarts.size());
+            for (std::size_t w = 0; w < windowStarts.size(); ++w)
+            {
+                const int start = windowStarts[w];
+                const int end = std::min(start + windowSize, n);
+                WindowBoundary& boundary = boundaries[w];
+                boundary.startTime = start > 0 ? completion[start - 1] : 0;
+                boundary.predecessor = start > 0 ? schedule[start - 1] : -1;
+                boundary.pinnedJob = end < n ? schedule[end - 1] : -1;
+                boundary.pinnedCompletion = completion[end - 1];
+                boundary.suffixTardyWeight = tardyWeightFrom[end];
+            }
+
+            std::atomic<int> nextWindow{0};
+            std::atomic<long long> acceptedInPhase{0};
+            auto worker = [&](int workerIndex) {
+                // Pinned workers read the instance from their node's replica
+                const int node = numa != nullptr ? numa->nodeForWorker(workerIndex) : 0;
+                if (numa != nullptr) numa->pinWorker(workerIndex);
+                const std::vector<Order>& localOrders = numa != nullptr ? numa->orders(node) : orders;
+                const SetupTimes& localSetupTimes = numa != nullptr ? numa->setupTimes(node) : setupTimes;
+                const std::vector<int>& localInitialSetupTimes =
+                    numa != nullptr ? numa->initialSetupTimes(node) : initialSetupTimes;
+
+                for (int w = nextWindow++; w < static_cast<int>(windowStarts.size()); w = nextWindow++)
+                {
+                    const int start = windowStarts[w];
+                    const int end = std::min(start + windowSize, n);
+
+                    // Stream depends on the window only, so any thread count gives the same schedule
+                    std::seed_seq seeds{seed, static_cast<unsigned int>(pass), static_cast<unsigned int>(phase),
+                                        static_cast<unsigned int>(w)};
+                    std::mt19937 rng(seeds);
+                    if (optimizeWindow(schedule, start, end, boundaries[w], localOrders, localSetupTimes,
+                                       localInitialSetupTimes, config.useILS, rng))
+                    {
+                        ++acceptedInPhase;
+                    }
+                    ++windowsOptimized;
+                    ++windowsByWorker[workerIndex];
+                }
+            };
+
+            // With NUMA placement every worker gets its own thread so the caller's affinity is left alone
+            std::vector<std::thread> threads;
+            for (int t = numa != nullptr ? 0 : 1; t < std::min<int>(numThreads, windowStarts.size()); ++t)
+            {
+                threads.emplace_back(worker, t);
+            }
+            if (numa == nullptr)
+            {
+                worker(0);
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+            acceptedInPass += acceptedInPhase;
+        }
+        windowsAccepted += acceptedInPass;
+
+        ScheduleData passData;
+        passData.schedule = schedule;
+        calculateTotalPenalty(passData, orders, setupTimes, initialSetupTimes);
+        std::cout << "Rolling horizon pass " << pass + 1 << ": penalty " << passData.totalPenalty
+                  << " (" << acceptedInPass << " windows improved)" << std::endl;
+        if (acceptedInPass == 0)
+        {
+            break;  // Every window is locally optimal for its optimizer
+        }
+    }
+
+    ScheduleData result;
+    result.schedule = schedule;
+    calculateTotalPenalty(result, orders, setupTimes, initialSetupTimes);
+    totalPenaltyCost = result.totalPenalty;
+    if (numa != nullptr)
+    {
+        NumaThroughput throughput(numa->topology());
+        for (int t = 0; t < numThreads; ++t)
+        {
+            if (windowsByWorker[t] > 0) throughput.addWorker(numa->nodeForWorker(t), windowsByWorker[t]);
+        }
+        throughput.print(config.useILS ? "ROLLING_HORIZON_ILS" : "ROLLING_HORIZON_RVND", "windows",
+                         std::chrono::duration<double>(std::chrono::steady_clock::now() - searchStart).count());
+    }
+    if (stats != nullptr)
+    {
+        stats->windowsOptimized = windowsOptimized;
+        stats->windowsAccepted = windowsAccepted;
+    }
+    return schedule;
+}
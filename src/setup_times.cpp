@@ -0,0 +1,63 @@
+// setup_times.cpp
+
+#include "setup_times.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+std::atomic<std::uint64_t> nextObjectId{1};
+
+} // namespace
+
+std::uint64_t SetupTimes::newObjectId()
+{
+    return nextObjectId.fetch_add(1, std::memory_order_relaxed);
+}
+
+SetupTimes::SetupTimes(int numOrders)
+    : matrix(static_cast<std::size_t>(numOrders) * numOrders, 0), families(numOrders), familyCount(numOrders)
+{
+    std::iota(families.begin(), families.end(), 0);
+}
+
+SetupTimes::SetupTimes(std::vector<int> familyOf, int numFamilies)
+    : matrix(static_cast<std::size_t>(numFamilies) * numFamilies, 0), families(std::move(familyOf)),
+      familyCount(numFamilies), isClustered(true) {}
+
+SetupTimes::SetupTimes(const SetupTimes& other)
+    : matrix(other.matrix), families(other.families), familyCount(other.familyCount),
+      isClustered(other.isClustered) {}
+
+SetupTimes::SetupTimes(SetupTimes&& other) noexcept
+    : matrix(std::move(other.matrix)), families(std::move(other.families)), familyCount(other.familyCount),
+      isClustered(other.isClustered) {}
+
+SetupTimes& SetupTimes::operator=(const SetupTimes& other)
+{
+    matrix = other.matrix;
+    families = other.families;
+    familyCount = other.familyCount;
+    isClustered = other.isClustered;
+    objectId = newObjectId();
+    revision = 0;
+    return *this;
+}
+
+SetupTimes& SetupTimes::operator=(SetupTimes&& other) noexcept
+{
+    matrix = std::move(other.matrix);
+    families = std::move(other.families);
+    familyCount = other.familyCount;
+    isClustered = other.isClustered;
+    objectId = newObjectId();
+    revision = 0;
+    return *this;
+}
+
+int SetupTimes::maxSetup() const
+{
+    return matrix.empty() ? 0 : *std::max_element(matrix.begin(), matrix.end());
+}
@@ -0,0 +1,133 @@
+// test_batch_evaluator.cpp
+
+#include "batch_evaluator.h"
+#include "neighborhood_kernels.h"
+#include "test_support.h"
+
+namespace {
+
+using Schedule = std::vector<int>;
+using Cost = IntegerPenalty;
+
+// Least penalty over every candidate that move(schedule, i, j, length) produces, or the current one
+template <typename Move>
+double bruteForceBest(const Schedule& schedule, const TestInstance& instance, int length, Move move)
+{
+    const int n = schedule.size();
+    double best = referencePenalty(schedule, instance);
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            Schedule candidate = schedule;
+            if (move(candidate, i, j, length)) best = std::min(best, referencePenalty(candidate, instance));
+        }
+    }
+    return best;
+}
+
+bool swapMove(Schedule& schedule, int i, int j, int length)
+{
+    const int n = schedule.size();
+    if (j < i + length || j + length > n) return false;
+    std::swap_ranges(schedule.begin() + i, schedule.begin() + i + length, schedule.begin() + j);
+    return true;
+}
+
+// Block at i moved so that it starts at j (j < i) or ends just before j (j > i)
+bool reinsertionMove(Schedule& schedule, int i, int j, int length)
+{
+    const int n = schedule.size();
+    if (i + length > n || j + length > n || (j >= i && j < i + length)) return false;
+    const Schedule block(schedule.begin() + i, schedule.begin() + i + length);
+    schedule.erase(schedule.begin() + i, schedule.begin() + i + length);
+    schedule.insert(schedule.begin() + (j < i ? j : j - length), block.begin(), block.end());
+    return true;
+}
+
+bool reversalMove(Schedule& schedule, int i, int, int length)
+{
+    if (i + length > static_cast<int>(schedule.size())) return false;
+    std::reverse(schedule.begin() + i, schedule.begin() + i + length);
+    return true;
+}
+
+/**
+ * Runs each scalar kernel and its batched counterpart from the same starting
+ * candidate; both must pick the same move, worth the brute-force best.
+ */
+template <std::size_t Count, typename Move>
+bool checkKernels(const std::array<ScanKernel<Schedule, Cost>, Count>& scalarKernels,
+                  const std::array<BatchScanKernel<Schedule, Cost>, Count>& batchKernels, int firstLength,
+                  Move move, const TestInstance& instance, Schedule& schedule, BatchEvaluator& batch)
+{
+    PrefixTimeline<Cost> timeline;
+    buildPrefixTimeline(schedule, instance.orders, instance.setupTimes, instance.initialSetupTimes, timeline);
+    const Cost current = timeline.penalty[schedule.size()];
+    for (std::size_t k = 0; k < Count; ++k)
+    {
+        MoveCandidate<Cost> scalarBest{current};
+        MoveCandidate<Cost> batchBest{current};
+        scalarKernels[k](schedule, timeline, instance.orders, instance.setupTimes, instance.initialSetupTimes,
+                         scalarBest);
+        batchKernels[k](schedule, timeline, batch, batchBest);
+        CHECK(batchBest.penalty == scalarBest.penalty);
+        CHECK(batchBest.i == scalarBest.i);
+        CHECK(batchBest.j == scalarBest.j);
+        CHECK(batchBest.length == scalarBest.length);
+        CHECK(scalarBest.penalty == bruteForceBest(schedule, instance, firstLength + k, move));
+    }
+    return true;
+}
+
+} // namespace
+
+bool testBatchKernelsMatchScalar()
+{
+    BatchEvaluator batch;
+    if (std::string(BatchEvaluator::instructionSet()) == "scalar")
+    {
+        std::cout << "no vector unit, batch kernels not checked" << std::endl;
+        return true;
+    }
+
+    std::mt19937 rng(31);
+    for (int trial = 0; trial < 12; ++trial)
+    {
+        const int n = 20 + 3 * trial;
+        const TestInstance instance = randomInstance(n, trial % 2 == 0 ? 0 : 1 + trial % 5, rng);
+        batch.load(instance.orders, instance.setupTimes, instance.initialSetupTimes);
+        CHECK(batch.enabled());
+        Schedule schedule = randomSchedule(n, rng);
+        const Schedule original = schedule;
+        if (!checkKernels(swapScanKernels<Schedule, Cost>, swapBatchKernels<Schedule, Cost>, 1, swapMove,
+                          instance, schedule, batch)) return false;
+        if (!checkKernels(reinsertionScanKernels<Schedule, Cost>, reinsertionBatchKernels<Schedule, Cost>, 1,
+                          reinsertionMove, instance, schedule, batch)) return false;
+        if (!checkKernels(reversalScanKernels<Schedule, Cost>, reversalBatchKernels<Schedule, Cost>, 2,
+                          reversalMove, instance, schedule, batch)) return false;
+        CHECK(schedule == original);
+    }
+    return true;
+}
+
+bool testBatchEvaluatorReloadsChangedTable()
+{
+    // Same vectors, new setup values: load() must notice through the table identity
+    BatchEvaluator batch;
+    if (std::string(BatchEvaluator::instructionSet()) == "scalar") return true;
+
+    std::mt19937 rng(310);
+    TestInstance instance = randomInstance(16, 0, rng);
+    const Schedule schedule = randomSchedule(16, rng);
+    double penalties[BATCH_MAX_LANES];
+    for (int round = 0; round < 3; ++round)
+    {
+        batch.load(instance.orders, instance.setupTimes, instance.initialSetupTimes);
+        batch.beginBatch(schedule, 0, 0);
+        batch.evaluate(penalties);
+        for (int lane = 0; lane < batch.lanes(); ++lane) CHECK(penalties[lane] == referencePenalty(schedule, instance));
+        instance.setupTimes.entry(schedule[3], schedule[4]) += 50;
+    }
+    return true;
+}
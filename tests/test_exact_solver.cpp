@@ -0,0 +1,73 @@
+// test_exact_solver.cpp
+
+#include "exact_solver.h"
+#include "test_support.h"
+
+namespace {
+
+// Small dense and clustered instances, with integral and fractional penalty rates
+std::vector<TestInstance> smallInstances()
+{
+    std::mt19937 rng(26);
+    std::vector<TestInstance> instances;
+    for (int n = 1; n <= 7; ++n)
+    {
+        instances.push_back(randomInstance(n, 0, rng));
+        instances.push_back(randomInstance(n, 3, rng));
+        instances.push_back(randomInstance(n, 2, rng, false));
+    }
+    return instances;
+}
+
+bool checkOptimal(const ExactResult& result, const TestInstance& instance)
+{
+    const double optimum = bruteForceOptimum(instance);
+    CHECK(result.provenOptimal);
+    CHECK(isPermutation(result.schedule, instance.orders.size()));
+    CHECK(result.penalty == optimum);
+    CHECK(referencePenalty(result.schedule, instance) == optimum);
+    CHECK(result.lowerBound <= optimum);
+    return true;
+}
+
+} // namespace
+
+bool testDynamicProgrammingMatchesBruteForce()
+{
+    for (const TestInstance& instance : smallInstances())
+    {
+        const ExactResult result = dynamicProgrammingSolve(instance.orders, instance.setupTimes,
+                                                           instance.initialSetupTimes, {}, 10.0);
+        if (!checkOptimal(result, instance)) return false;
+    }
+    return true;
+}
+
+bool testBranchAndBoundMatchesBruteForce()
+{
+    for (const TestInstance& instance : smallInstances())
+    {
+        for (int threads : {1, 3})
+        {
+            const ExactResult result = branchAndBoundSolve(instance.orders, instance.setupTimes,
+                                                           instance.initialSetupTimes, {}, 10.0, threads);
+            if (!checkOptimal(result, instance)) return false;
+        }
+    }
+    return true;
+}
+
+bool testExactSolverImprovesIncumbent()
+{
+    std::mt19937 rng(260);
+    for (int trial = 0; trial < 10; ++trial)
+    {
+        const TestInstance instance = randomInstance(7, trial % 2 == 0 ? 0 : 3, rng);
+        const std::vector<int> incumbent = randomSchedule(7, rng);
+        const ExactResult result = solveExact(instance.orders, instance.setupTimes, instance.initialSetupTimes,
+                                              incumbent, 10.0, 1);
+        if (!checkOptimal(result, instance)) return false;
+        CHECK(result.penalty <= referencePenalty(incumbent, instance));
+    }
+    return true;
+}
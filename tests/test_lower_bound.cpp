@@ -0,0 +1,77 @@
+// test_lower_bound.cpp
+
+#include "lower_bound.h"
+#include "test_support.h"
+
+namespace {
+
+// Least penalty of the unscheduled jobs over every order in which they can follow the prefix
+double bestCompletion(const std::vector<int>& prefix, const TestInstance& instance)
+{
+    const int n = instance.orders.size();
+    std::vector<char> scheduled(n, 0);
+    for (int job : prefix) scheduled[job] = 1;
+    std::vector<int> schedule = prefix;
+    for (int job = 0; job < n; ++job)
+    {
+        if (!scheduled[job]) schedule.push_back(job);
+    }
+
+    const double prefixPenalty = referencePenalty(prefix, instance);
+    double best = referencePenalty(schedule, instance) - prefixPenalty;
+    while (std::next_permutation(schedule.begin() + prefix.size(), schedule.end()))
+    {
+        best = std::min(best, referencePenalty(schedule, instance) - prefixPenalty);
+    }
+    return best;
+}
+
+long long completionTime(const std::vector<int>& prefix, const TestInstance& instance)
+{
+    long long time = 0;
+    for (std::size_t k = 0; k < prefix.size(); ++k)
+    {
+        time += (k > 0 ? instance.setupTimes(prefix[k - 1], prefix[k]) : instance.initialSetupTimes[prefix[k]]) +
+                instance.orders[prefix[k]].processingTime;
+    }
+    return time;
+}
+
+} // namespace
+
+bool testLowerBoundBelowOptimum()
+{
+    std::mt19937 rng(27);
+    for (int trial = 0; trial < 60; ++trial)
+    {
+        const int n = 1 + trial % 7;
+        const TestInstance instance = randomInstance(n, trial % 3 == 0 ? 0 : 1 + trial % 4, rng, trial % 2 == 0);
+        const double bound = computeLowerBound(instance.orders, instance.setupTimes, instance.initialSetupTimes);
+        CHECK(bound >= 0.0);
+        CHECK(bound <= bruteForceOptimum(instance) + 1e-9);
+    }
+    return true;
+}
+
+bool testRemainingBoundBelowBestCompletion()
+{
+    std::mt19937 rng(270);
+    for (int trial = 0; trial < 60; ++trial)
+    {
+        const int n = 2 + trial % 6;
+        const TestInstance instance = randomInstance(n, trial % 2 == 0 ? 0 : 3, rng, trial % 3 != 0);
+        const std::vector<int> minIncoming = computeMinIncomingSetups(instance.setupTimes);
+        const std::vector<int> order = randomSchedule(n, rng);
+        for (int length = 0; length < n; ++length)
+        {
+            const std::vector<int> prefix(order.begin(), order.begin() + length);
+            std::vector<char> scheduled(n, 0);
+            for (int job : prefix) scheduled[job] = 1;
+            const double bound = remainingPenaltyBound(scheduled, completionTime(prefix, instance),
+                                                       length > 0 ? prefix.back() : -1, instance.orders,
+                                                       instance.setupTimes, instance.initialSetupTimes, minIncoming);
+            CHECK(bound <= bestCompletion(prefix, instance) + 1e-9);
+        }
+    }
+    return true;
+}
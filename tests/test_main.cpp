@@ -0,0 +1,76 @@
+// test_main.cpp
+// Runs the test named on the command line, or every test when none is given.
+
+#include <cstring>
+#include <iostream>
+
+bool testDynamicProgrammingMatchesBruteForce();
+bool testBranchAndBoundMatchesBruteForce();
+bool testExactSolverImprovesIncumbent();
+bool testLowerBoundBelowOptimum();
+bool testRemainingBoundBelowBestCompletion();
+bool testIntegralRatesDetected();
+bool testPenaltyTypeFollowsInstance();
+bool testBatchKernelsMatchScalar();
+bool testBatchEvaluatorReloadsChangedTable();
+bool testClusteredFileMatchesDenseExpansion();
+bool testSetupModelDispatch();
+bool testSetupTableIdentity();
+bool testRangeTardinessIndex();
+bool testSummaryPiecesMatchDirectEvaluation();
+bool testLongReversalsMatchBruteForce();
+bool testRollingHorizonAcceptRule();
+bool testRollingHorizonThreadIndependent();
+bool testSummaryScansMatchBruteForce();
+bool testNeighborhoodCounters();
+
+namespace {
+
+struct TestCase {
+    const char* name;
+    bool (*run)();
+};
+
+const TestCase TESTS[] = {
+    {"exact_dp", testDynamicProgrammingMatchesBruteForce},
+    {"exact_branch_and_bound", testBranchAndBoundMatchesBruteForce},
+    {"exact_incumbent", testExactSolverImprovesIncumbent},
+    {"lower_bound", testLowerBoundBelowOptimum},
+    {"lower_bound_remaining", testRemainingBoundBelowBestCompletion},
+    {"penalty_integral_rates", testIntegralRatesDetected},
+    {"penalty_type_per_instance", testPenaltyTypeFollowsInstance},
+    {"batch_kernels", testBatchKernelsMatchScalar},
+    {"batch_reload", testBatchEvaluatorReloadsChangedTable},
+    {"setup_times_clustered_parser", testClusteredFileMatchesDenseExpansion},
+    {"setup_times_dispatch", testSetupModelDispatch},
+    {"setup_times_identity", testSetupTableIdentity},
+    {"summary_range_index", testRangeTardinessIndex},
+    {"summary_pieces", testSummaryPiecesMatchDirectEvaluation},
+    {"summary_long_reversals", testLongReversalsMatchBruteForce},
+    {"rolling_horizon_accept", testRollingHorizonAcceptRule},
+    {"rolling_horizon_threads", testRollingHorizonThreadIndependent},
+    {"neighborhood_summary_scans", testSummaryScansMatchBruteForce},
+    {"neighborhood_counters", testNeighborhoodCounters},
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int failures = 0;
+    int run = 0;
+    for (const TestCase& test : TESTS)
+    {
+        if (argc > 1 && std::strcmp(argv[1], test.name) != 0) continue;
+        ++run;
+        const bool passed = test.run();
+        std::cout << (passed ? "PASS " : "FAIL ") << test.name << std::endl;
+        failures += passed ? 0 : 1;
+    }
+    if (run == 0)
+    {
+        std::cerr << "Unknown test: " << argv[1] << std::endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
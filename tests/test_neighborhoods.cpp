@@ -0,0 +1,178 @@
+// test_neighborhoods.cpp
+
+#include "algorithm.h"
+#include "neighborhood_kernels.h"
+#include "neighborhoods.h"
+#include "test_support.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+using Schedule = std::vector<int>;
+using Neighborhood = bool (*)(ScheduleData&, const std::vector<Order>&, const SetupTimes&, const std::vector<int>&);
+
+bool samePenalty(double a, double b)
+{
+    return std::abs(a - b) <= 1e-9 * std::max({1.0, std::abs(a), std::abs(b)});
+}
+
+// Blocks [i, i + first) and [j, j + second) exchanged, written out piece by piece
+Schedule exchanged(const Schedule& schedule, int i, int first, int j, int second)
+{
+    Schedule result(schedule.begin(), schedule.begin() + i);
+    result.insert(result.end(), schedule.begin() + j, schedule.begin() + j + second);
+    result.insert(result.end(), schedule.begin() + i + first, schedule.begin() + j);
+    result.insert(result.end(), schedule.begin() + i, schedule.begin() + i + first);
+    result.insert(result.end(), schedule.begin() + j + second, schedule.end());
+    return result;
+}
+
+// Block [i, i + length) reversed and reinserted so that it starts at target
+Schedule reversedReinsertion(const Schedule& schedule, int i, int length, int target)
+{
+    Schedule block(schedule.begin() + i, schedule.begin() + i + length);
+    std::reverse(block.begin(), block.end());
+    Schedule result = schedule;
+    result.erase(result.begin() + i, result.begin() + i + length);
+    result.insert(result.begin() + target, block.begin(), block.end());
+    return result;
+}
+
+double bestUnequalExchange(const Schedule& schedule, const TestInstance& instance)
+{
+    const int n = schedule.size();
+    double best = referencePenalty(schedule, instance);
+    for (int i = 0; i < n; ++i)
+    {
+        for (int first = 1; first <= MAX_OR_OPT_LENGTH; ++first)
+        {
+            for (int second = 1; second <= MAX_OR_OPT_LENGTH; ++second)
+            {
+                if (first == second) continue;
+                for (int j = i + first; j + second <= n; ++j)
+                {
+                    best = std::min(best, referencePenalty(exchanged(schedule, i, first, j, second), instance));
+                }
+            }
+        }
+    }
+    return best;
+}
+
+double bestOrOpt(const Schedule& schedule, const TestInstance& instance)
+{
+    const int n = schedule.size();
+    double best = referencePenalty(schedule, instance);
+    for (int length = 2; length <= MAX_OR_OPT_LENGTH; ++length)
+    {
+        for (int i = 0; i + length <= n; ++i)
+        {
+            for (int target = 0; target + length <= n; ++target)
+            {
+                if (target == i) continue;
+                best = std::min(best, referencePenalty(reversedReinsertion(schedule, i, length, target), instance));
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * Both summary scans must find the brute-force best move, leave the schedule
+ * untouched, and report a move that exchangeBlocks / reinsertBlock turn into
+ * a schedule of the reported penalty.
+ */
+template <typename Cost>
+bool checkSummaryScans(bool integral, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    for (int trial = 0; trial < 40; ++trial)
+    {
+        const int n = 2 + trial % 25;
+        const TestInstance instance = randomInstance(n, trial % 2 == 0 ? 0 : 1 + trial % 5, rng, integral);
+        Schedule schedule = randomSchedule(n, rng);
+        const Schedule original = schedule;
+
+        PrefixTimeline<Cost> timeline;
+        ScheduleSummary<Cost> summary;
+        buildPrefixTimeline(schedule, instance.orders, instance.setupTimes, instance.initialSetupTimes, timeline);
+        buildScheduleSummary(schedule, instance.orders, instance.setupTimes, instance.initialSetupTimes, summary);
+
+        MoveCandidate<Cost> exchange{timeline.penalty[n]};
+        scanUnequalBlockExchanges(schedule, timeline, summary, instance.orders, instance.setupTimes,
+                                  instance.initialSetupTimes, exchange);
+        MoveCandidate<Cost> orOpt{timeline.penalty[n]};
+        scanOrOptMoves(schedule, timeline, summary, instance.orders, instance.setupTimes,
+                       instance.initialSetupTimes, orOpt);
+        CHECK(schedule == original);
+
+        CHECK(samePenalty(static_cast<double>(exchange.penalty), bestUnequalExchange(schedule, instance)));
+        CHECK(samePenalty(static_cast<double>(orOpt.penalty), bestOrOpt(schedule, instance)));
+        if (exchange.length > 0)
+        {
+            Schedule moved = schedule;
+            exchangeBlocks(moved, exchange.i, exchange.length, exchange.j, exchange.otherLength);
+            CHECK(moved == exchanged(schedule, exchange.i, exchange.length, exchange.j, exchange.otherLength));
+            CHECK(samePenalty(static_cast<double>(exchange.penalty), referencePenalty(moved, instance)));
+        }
+        if (orOpt.length > 0)
+        {
+            Schedule moved = schedule;
+            reinsertBlock(moved, orOpt.i, orOpt.length, orOpt.j, true);
+            CHECK(moved == reversedReinsertion(schedule, orOpt.i, orOpt.length, orOpt.j));
+            CHECK(samePenalty(static_cast<double>(orOpt.penalty), referencePenalty(moved, instance)));
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool testSummaryScansMatchBruteForce()
+{
+    return checkSummaryScans<IntegerPenalty>(true, 41) && checkSummaryScans<double>(false, 410);
+}
+
+bool testNeighborhoodCounters()
+{
+    // Each neighborhood counts its own improvements, and only those
+    const std::array<std::atomic<int>*, 5> counters = {
+        &swap_improvement_count, &block_shift_improvement_count, &two_opt_improvement_count,
+        &block_exchange_improvement_count, &or_opt_improvement_count};
+    const std::array<Neighborhood, 5> neighborhoods = {
+        swapNeighborhood<Schedule>, reinsertionNeighborhood<Schedule>, twoOptNeighborhood<Schedule>,
+        blockExchangeNeighborhood<Schedule>, orOptNeighborhood<Schedule>};
+
+    std::mt19937 rng(411);
+    std::array<int, 5> improvements = {};
+    for (int trial = 0; trial < 30; ++trial)
+    {
+        const int n = 12 + trial;
+        const TestInstance instance = randomInstance(n, trial % 2 == 0 ? 0 : 4, rng, trial % 3 != 0);
+        for (std::size_t k = 0; k < neighborhoods.size(); ++k)
+        {
+            ScheduleData scheduleData;
+            scheduleData.schedule = randomSchedule(n, rng);
+            scheduleData.totalPenalty = referencePenalty(scheduleData.schedule, instance);
+            const double before = scheduleData.totalPenalty;
+
+            std::array<int, 5> countsBefore;
+            for (std::size_t c = 0; c < counters.size(); ++c) countsBefore[c] = counters[c]->load();
+            const bool improved = neighborhoods[k](scheduleData, instance.orders, instance.setupTimes,
+                                                   instance.initialSetupTimes);
+            for (std::size_t c = 0; c < counters.size(); ++c)
+            {
+                CHECK(counters[c]->load() - countsBefore[c] == (c == k && improved ? 1 : 0));
+            }
+            CHECK(isPermutation(scheduleData.schedule, n));
+            CHECK(samePenalty(scheduleData.totalPenalty, referencePenalty(scheduleData.schedule, instance)));
+            CHECK(improved == (scheduleData.totalPenalty < before));
+            improvements[k] += improved ? 1 : 0;
+        }
+    }
+    // Random schedules leave room for every neighborhood, so each counter must have moved
+    for (int count : improvements) CHECK(count > 0);
+    return true;
+}
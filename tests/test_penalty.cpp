@@ -0,0 +1,62 @@
+// test_penalty.cpp
+
+#include "algorithm.h"
+#include "parser.h"
+#include "penalty.h"
+#include "schedule_data.h"
+#include "test_support.h"
+#include <cstdio>
+
+namespace {
+
+double evaluate(const std::vector<int>& schedule, const TestInstance& instance)
+{
+    ScheduleData scheduleData;
+    scheduleData.schedule = schedule;
+    calculateTotalPenalty(scheduleData, instance.orders, instance.setupTimes, instance.initialSetupTimes);
+    return scheduleData.totalPenalty;
+}
+
+TestInstance parse(const TestInstance& instance, const std::string& name)
+{
+    const std::string path = writeInstanceFile(instance, name);
+    TestInstance parsed;
+    parseInputFile(path, parsed.orders, parsed.setupTimes, parsed.initialSetupTimes);
+    std::remove(path.c_str());
+    return parsed;
+}
+
+} // namespace
+
+bool testIntegralRatesDetected()
+{
+    std::mt19937 rng(30);
+    const TestInstance integral = randomInstance(12, 0, rng, true);
+    TestInstance fractional = integral;
+    CHECK(hasIntegralPenaltyRates(integral.orders));
+    fractional.orders[5].penaltyRate += 0.5;
+    CHECK(!hasIntegralPenaltyRates(fractional.orders));
+    CHECK(hasIntegralPenaltyRates({}));
+    return true;
+}
+
+bool testPenaltyTypeFollowsInstance()
+{
+    // Each instance keeps its own evaluation path whatever was parsed after it
+    std::mt19937 rng(300);
+    for (int trial = 0; trial < 10; ++trial)
+    {
+        const bool fractionalFirst = trial % 2 == 0;
+        const TestInstance first = parse(randomInstance(15, trial % 3, rng, !fractionalFirst), "first");
+        const TestInstance second = parse(randomInstance(15, trial % 3, rng, fractionalFirst), "second");
+        CHECK(hasIntegralPenaltyRates(first.orders) == !fractionalFirst);
+        CHECK(hasIntegralPenaltyRates(second.orders) == fractionalFirst);
+        for (int k = 0; k < 5; ++k)
+        {
+            const std::vector<int> schedule = randomSchedule(15, rng);
+            CHECK(evaluate(schedule, first) == referencePenalty(schedule, first));
+            CHECK(evaluate(schedule, second) == referencePenalty(schedule, second));
+        }
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+// test_rolling_horizon.cpp
+
+#include "rolling_horizon.h"
+#include "test_support.h"
+
+namespace {
+
+/**
+ * A window is accepted only if it lowers its own penalty without delaying the
+ * job after it, so the returned schedule must be a permutation whose penalty
+ * is the reported one, strictly lower than the initial one whenever a window
+ * was accepted, and never below the optimum.
+ */
+bool checkSearch(const TestInstance& instance, const RollingHorizonConfig& config, unsigned seed, std::mt19937& rng)
+{
+    const int n = instance.orders.size();
+    const std::vector<int> initial = randomSchedule(n, rng);
+    const double initialPenalty = referencePenalty(initial, instance);
+    double penalty = -1.0;
+    RollingHorizonStats stats;
+    const std::vector<int> result = rollingHorizonSearch(initial, instance.orders, instance.setupTimes,
+                                                         instance.initialSetupTimes, penalty, seed, config, &stats);
+    CHECK(isPermutation(result, n));
+    CHECK(penalty == referencePenalty(result, instance));
+    CHECK(penalty <= initialPenalty);
+    CHECK(stats.windowsAccepted <= stats.windowsOptimized);
+    CHECK((stats.windowsAccepted > 0) == (penalty < initialPenalty));
+    if (n <= 8) CHECK(penalty >= bruteForceOptimum(instance));
+    return true;
+}
+
+} // namespace
+
+bool testRollingHorizonAcceptRule()
+{
+    std::mt19937 rng(33);
+    for (int trial = 0; trial < 12; ++trial)
+    {
+        const int n = trial < 4 ? 6 + trial % 3 : 30 + 10 * trial;
+        const TestInstance instance = randomInstance(n, trial % 3 == 0 ? 0 : 4, rng, trial % 2 == 0);
+        RollingHorizonConfig config;
+        config.windowSize = 3 + trial % 6;
+        config.useILS = trial % 4 == 1;
+        config.numThreads = 1 + trial % 3;
+        if (!checkSearch(instance, config, 330 + trial, rng)) return false;
+    }
+    return true;
+}
+
+bool testRollingHorizonThreadIndependent()
+{
+    std::mt19937 rng(331);
+    for (int trial = 0; trial < 4; ++trial)
+    {
+        const TestInstance instance = randomInstance(80, trial % 2 == 0 ? 0 : 5, rng);
+        const std::vector<int> initial = randomSchedule(80, rng);
+        RollingHorizonConfig config;
+        config.windowSize = 8;
+        config.useILS = false;
+
+        config.numThreads = 1;
+        double sequentialPenalty = 0.0;
+        const std::vector<int> sequential = rollingHorizonSearch(initial, instance.orders, instance.setupTimes,
+                                                                 instance.initialSetupTimes, sequentialPenalty,
+                                                                 7 + trial, config);
+        config.numThreads = 3;
+        double parallelPenalty = 0.0;
+        const std::vector<int> parallel = rollingHorizonSearch(initial, instance.orders, instance.setupTimes,
+                                                               instance.initialSetupTimes, parallelPenalty,
+                                                               7 + trial, config);
+        CHECK(parallel == sequential);
+        CHECK(parallelPenalty == sequentialPenalty);
+    }
+    return true;
+}
@@ -0,0 +1,171 @@
+// test_segment_summary.cpp
+
+#include "neighborhood_kernels.h"
+#include "segment_summary.h"
+#include "test_support.h"
+#include <cmath>
+
+namespace {
+
+using Schedule = std::vector<int>;
+
+// Penalty of jobs appended one by one after lastTask at time; both are advanced
+template <typename Cost>
+Cost appendDirectly(const Schedule& jobs, const TestInstance& instance, long long& time, int& lastTask)
+{
+    Cost penalty = 0;
+    for (int job : jobs)
+    {
+        const Order& order = instance.orders[job];
+        time += (lastTask >= 0 ? instance.setupTimes(lastTask, job) : instance.initialSetupTimes[job]) +
+                order.processingTime;
+        if (time > order.dueTime) penalty += penaltyRateAs<Cost>(order) * (time - order.dueTime);
+        lastTask = job;
+    }
+    return penalty;
+}
+
+template <typename Cost>
+bool samePenalty(Cost a, Cost b)
+{
+    if constexpr (std::is_same_v<Cost, IntegerPenalty>)
+    {
+        return a == b;
+    }
+    else
+    {
+        return std::abs(a - b) <= 1e-9 * std::max({1.0, std::abs(a), std::abs(b)});
+    }
+}
+
+/**
+ * Every forward and reversed piece of a random schedule, appended at random
+ * times after random tasks (or first), must cost what the jobs cost one by one.
+ */
+template <typename Cost>
+bool checkPieces(bool integral, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    for (int trial = 0; trial < 8; ++trial)
+    {
+        const int n = 3 + 5 * trial;
+        const TestInstance instance = randomInstance(n, trial % 2 == 0 ? 0 : 2 + trial % 3, rng, integral);
+        const Schedule schedule = randomSchedule(n, rng);
+        ScheduleSummary<Cost> summary;
+        buildScheduleSummary(schedule, instance.orders, instance.setupTimes, instance.initialSetupTimes, summary);
+
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = i; j < n; ++j)
+            {
+                const long long startTime = rng() % (n * 40 + 1);
+                const int previousTask = static_cast<int>(rng() % (n + 1)) - 1;
+
+                Schedule piece(schedule.begin() + i, schedule.begin() + j + 1);
+                long long expectedTime = startTime;
+                int expectedLast = previousTask;
+                Cost expected = appendDirectly<Cost>(piece, instance, expectedTime, expectedLast);
+                long long time = startTime;
+                int lastTask = previousTask;
+                const Cost forward = appendForwardPiece(summary, schedule, i, j, instance.orders, instance.setupTimes,
+                                                        instance.initialSetupTimes, time, lastTask);
+                CHECK(samePenalty(forward, expected));
+                CHECK(time == expectedTime);
+                CHECK(lastTask == expectedLast);
+
+                std::reverse(piece.begin(), piece.end());
+                expectedTime = startTime;
+                expectedLast = previousTask;
+                expected = appendDirectly<Cost>(piece, instance, expectedTime, expectedLast);
+                time = startTime;
+                lastTask = previousTask;
+                const Cost reversed = appendReversedPiece(summary, schedule, i, j, instance.setupTimes,
+                                                          instance.initialSetupTimes, time, lastTask);
+                CHECK(samePenalty(reversed, expected));
+                CHECK(time == expectedTime);
+                CHECK(lastTask == expectedLast);
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Cost>
+bool checkLongReversals(bool integral, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    for (int trial = 0; trial < 8; ++trial)
+    {
+        const int n = MAX_REVERSAL_LENGTH + 2 + 3 * trial;
+        const TestInstance instance = randomInstance(n, trial % 2 == 0 ? 0 : 3, rng, integral);
+        Schedule schedule = randomSchedule(n, rng);
+        const Schedule original = schedule;
+
+        PrefixTimeline<Cost> timeline;
+        ScheduleSummary<Cost> summary;
+        buildPrefixTimeline(schedule, instance.orders, instance.setupTimes, instance.initialSetupTimes, timeline);
+        buildScheduleSummary(schedule, instance.orders, instance.setupTimes, instance.initialSetupTimes, summary);
+        MoveCandidate<Cost> best{timeline.penalty[n]};
+        scanLongReversals(schedule, timeline, summary, instance.orders, instance.setupTimes,
+                          instance.initialSetupTimes, best);
+        CHECK(schedule == original);
+
+        double bruteForce = referencePenalty(schedule, instance);
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = i + MAX_REVERSAL_LENGTH; j < n; ++j)
+            {
+                Schedule candidate = schedule;
+                std::reverse(candidate.begin() + i, candidate.begin() + j + 1);
+                bruteForce = std::min(bruteForce, referencePenalty(candidate, instance));
+            }
+        }
+        CHECK(samePenalty(static_cast<double>(best.penalty), bruteForce));
+        if (best.i >= 0)
+        {
+            std::reverse(schedule.begin() + best.i, schedule.begin() + best.j + 1);
+            CHECK(samePenalty(static_cast<double>(best.penalty), referencePenalty(schedule, instance)));
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool testRangeTardinessIndex()
+{
+    std::mt19937 rng(40);
+    for (int n : {1, 2, 7, 8, 9, 33})
+    {
+        std::vector<long long> keys(n);
+        std::vector<IntegerPenalty> weights(n);
+        for (int k = 0; k < n; ++k)
+        {
+            keys[k] = static_cast<long long>(rng() % 200) - 100;
+            weights[k] = rng() % 10;
+        }
+        RangeTardinessIndex<IntegerPenalty> index;
+        index.build(keys, weights);
+        for (int lo = 0; lo <= n; ++lo)
+        {
+            for (int hi = lo; hi <= n; ++hi)
+            {
+                const long long threshold = static_cast<long long>(rng() % 240) - 120;
+                IntegerPenalty expected = 0;
+                for (int k = lo; k < hi; ++k) expected += weights[k] * std::max(0LL, threshold - keys[k]);
+                CHECK(index.tardiness(lo, hi, threshold) == expected);
+            }
+        }
+    }
+    return true;
+}
+
+bool testSummaryPiecesMatchDirectEvaluation()
+{
+    return checkPieces<IntegerPenalty>(true, 400) && checkPieces<double>(false, 401);
+}
+
+bool testLongReversalsMatchBruteForce()
+{
+    return checkLongReversals<IntegerPenalty>(true, 402) && checkLongReversals<double>(false, 403);
+}
@@ -0,0 +1,111 @@
+// test_setup_times.cpp
+
+#include "parser.h"
+#include "setup_times.h"
+#include "test_support.h"
+#include <cstdio>
+#include <type_traits>
+
+namespace {
+
+// Dense copy of a clustered instance: the same setups, one row per order
+TestInstance expandToDense(const TestInstance& clustered)
+{
+    TestInstance dense = clustered;
+    const int n = clustered.orders.size();
+    dense.setupTimes = SetupTimes(n);
+    for (int from = 0; from < n; ++from)
+    {
+        for (int to = 0; to < n; ++to) dense.setupTimes.entry(from, to) = clustered.setupTimes(from, to);
+    }
+    return dense;
+}
+
+TestInstance parse(const TestInstance& instance, const std::string& name)
+{
+    const std::string path = writeInstanceFile(instance, name);
+    TestInstance parsed;
+    parseInputFile(path, parsed.orders, parsed.setupTimes, parsed.initialSetupTimes);
+    std::remove(path.c_str());
+    return parsed;
+}
+
+} // namespace
+
+bool testClusteredFileMatchesDenseExpansion()
+{
+    std::mt19937 rng(39);
+    for (int trial = 0; trial < 10; ++trial)
+    {
+        const int n = 5 + 4 * trial;
+        const int numFamilies = 1 + trial % 4;
+        const TestInstance generated = randomInstance(n, numFamilies, rng);
+        const TestInstance clustered = parse(generated, "clustered");
+        const TestInstance dense = parse(expandToDense(generated), "dense");
+
+        CHECK(clustered.setupTimes.clustered());
+        CHECK(!dense.setupTimes.clustered());
+        CHECK(clustered.setupTimes.size() == n);
+        CHECK(clustered.setupTimes.numFamilies() == numFamilies);
+        CHECK(dense.setupTimes.numFamilies() == n);
+        CHECK(clustered.initialSetupTimes == generated.initialSetupTimes);
+        CHECK(dense.initialSetupTimes == generated.initialSetupTimes);
+        CHECK(clustered.setupTimes.maxSetup() == dense.setupTimes.maxSetup());
+
+        const ClusteredSetupView clusteredView(clustered.setupTimes);
+        const DenseSetupView denseView(dense.setupTimes);
+        for (int from = 0; from < n; ++from)
+        {
+            CHECK(clustered.setupTimes.family(from) == generated.setupTimes.family(from));
+            for (int to = 0; to < n; ++to)
+            {
+                const int expected = generated.setupTimes(from, to);
+                CHECK(clustered.setupTimes(from, to) == expected);
+                CHECK(clustered.setupTimes[from][to] == expected);
+                CHECK(clusteredView(from, to) == expected);
+                CHECK(dense.setupTimes(from, to) == expected);
+                CHECK(dense.setupTimes[from][to] == expected);
+                CHECK(denseView(from, to) == expected);
+            }
+        }
+
+        // Both layouts must give every schedule the same penalty
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::vector<int> schedule = randomSchedule(n, rng);
+            CHECK(referencePenalty(schedule, clustered) == referencePenalty(schedule, dense));
+        }
+    }
+    return true;
+}
+
+bool testSetupModelDispatch()
+{
+    std::mt19937 rng(390);
+    const TestInstance clustered = randomInstance(8, 3, rng);
+    const TestInstance dense = randomInstance(8, 0, rng);
+    const auto isClusteredView = [](const auto view) {
+        return std::is_same_v<decltype(view), const ClusteredSetupView>;
+    };
+    CHECK(visitSetupModel(clustered.setupTimes, isClusteredView));
+    CHECK(!visitSetupModel(dense.setupTimes, isClusteredView));
+    return true;
+}
+
+bool testSetupTableIdentity()
+{
+    std::mt19937 rng(391);
+    TestInstance instance = randomInstance(6, 2, rng);
+    const auto original = instance.setupTimes.identity();
+
+    SetupTimes copy = instance.setupTimes;
+    CHECK(copy.identity() != original);
+    CHECK(copy(1, 2) == instance.setupTimes(1, 2));
+
+    SetupTimes moved = std::move(copy);
+    CHECK(moved.identity() != original);
+
+    instance.setupTimes.entry(0, 1) += 1;
+    CHECK(instance.setupTimes.identity() != original);
+    return true;
+}
@@ -0,0 +1,164 @@
+// test_support.h
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "order.h"
+#include "setup_times.h"
+#include <unistd.h>
+
+// Fails the enclosing test (a function returning bool) with the location of the check
+#define CHECK(condition)                                                                            \
+    do                                                                                              \
+    {                                                                                               \
+        if (!(condition))                                                                           \
+        {                                                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            return false;                                                                           \
+        }                                                                                           \
+    } while (0)
+
+struct TestInstance {
+    std::vector<Order> orders;
+    SetupTimes setupTimes;
+    std::vector<int> initialSetupTimes;
+};
+
+/**
+ * Random instance with n orders whose due dates spread over the expected
+ * makespan, so that schedules mix early and tardy jobs. With numFamilies > 0 the
+ * setups are family-clustered, with initial setups that depend on the family only.
+ * Non-integral penalty rates exercise the double evaluation path.
+ */
+inline TestInstance randomInstance(int n, int numFamilies, std::mt19937& rng, bool integralRates = true)
+{
+    TestInstance instance;
+    std::vector<int> familyOf(n);
+    for (int& family : familyOf) family = numFamilies > 0 ? static_cast<int>(rng() % numFamilies) : 0;
+    instance.setupTimes = numFamilies > 0 ? SetupTimes(familyOf, numFamilies) : SetupTimes(n);
+    for (int from = 0; from < instance.setupTimes.numFamilies(); ++from)
+    {
+        for (int to = 0; to < instance.setupTimes.numFamilies(); ++to)
+        {
+            instance.setupTimes.entry(from, to) = static_cast<int>(rng() % 20);
+        }
+    }
+
+    std::vector<int> familyInitialSetup(std::max(numFamilies, 1));
+    for (int& setup : familyInitialSetup) setup = static_cast<int>(rng() % 15);
+    instance.orders.resize(n);
+    instance.initialSetupTimes.resize(n);
+    for (int k = 0; k < n; ++k)
+    {
+        Order& order = instance.orders[k];
+        order.id = k;
+        order.processingTime = 1 + static_cast<int>(rng() % 30);
+        order.dueTime = static_cast<int>(rng() % (n * 25 + 1));
+        order.penaltyRate = integralRates ? static_cast<double>(rng() % 10) : (rng() % 100) / 8.0;
+        order.integerPenaltyRate = static_cast<long long>(order.penaltyRate);
+        instance.initialSetupTimes[k] = numFamilies > 0 ? familyInitialSetup[familyOf[k]] : static_cast<int>(rng() % 15);
+    }
+    return instance;
+}
+
+// Penalty of a schedule, evaluated directly from the definition
+inline double referencePenalty(const std::vector<int>& schedule, const TestInstance& instance)
+{
+    double penalty = 0.0;
+    long long time = 0;
+    for (std::size_t k = 0; k < schedule.size(); ++k)
+    {
+        const int job = schedule[k];
+        const Order& order = instance.orders[job];
+        time += (k > 0 ? instance.setupTimes(schedule[k - 1], job) : instance.initialSetupTimes[job]) +
+                order.processingTime;
+        penalty += order.penaltyRate * std::max(0LL, time - order.dueTime);
+    }
+    return penalty;
+}
+
+// Optimal penalty by enumerating every permutation; only for a handful of orders
+inline double bruteForceOptimum(const TestInstance& instance)
+{
+    std::vector<int> schedule(instance.orders.size());
+    std::iota(schedule.begin(), schedule.end(), 0);
+    double best = referencePenalty(schedule, instance);
+    while (std::next_permutation(schedule.begin(), schedule.end()))
+    {
+        best = std::min(best, referencePenalty(schedule, instance));
+    }
+    return best;
+}
+
+inline std::vector<int> randomSchedule(int n, std::mt19937& rng)
+{
+    std::vector<int> schedule(n);
+    std::iota(schedule.begin(), schedule.end(), 0);
+    std::shuffle(schedule.begin(), schedule.end(), rng);
+    return schedule;
+}
+
+inline bool isPermutation(std::vector<int> schedule, int n)
+{
+    std::sort(schedule.begin(), schedule.end());
+    for (int k = 0; k < n; ++k)
+    {
+        if (static_cast<int>(schedule.size()) != n || schedule[k] != k) return false;
+    }
+    return true;
+}
+
+/**
+ * Writes the instance in the input file format read by parseInputFile: the
+ * family-clustered format when its setup table is clustered, the dense one
+ * otherwise. Returns the path of the file, unique to this process.
+ */
+inline std::string writeInstanceFile(const TestInstance& instance, const std::string& name)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("juice_test_" + name + "_" + std::to_string(getpid()) + ".txt");
+    std::ofstream file(path);
+    const int n = instance.orders.size();
+    const SetupTimes& setups = instance.setupTimes;
+    file << n;
+    if (setups.clustered()) file << " " << setups.numFamilies();
+    file << "\n\n";
+    for (const Order& order : instance.orders) file << order.processingTime << " ";
+    file << "\n";
+    for (const Order& order : instance.orders) file << order.dueTime << " ";
+    file << "\n";
+    for (const Order& order : instance.orders) file << order.penaltyRate << " ";
+    file << "\n\n";
+    if (setups.clustered())
+    {
+        std::vector<int> familyInitialSetup(setups.numFamilies(), 0);
+        for (int k = 0; k < n; ++k)
+        {
+            file << setups.family(k) << " ";
+            familyInitialSetup[setups.family(k)] = instance.initialSetupTimes[k];
+        }
+        file << "\n";
+        for (int setup : familyInitialSetup) file << setup << " ";
+        file << "\n";
+    }
+    else
+    {
+        for (int setup : instance.initialSetupTimes) file << setup << " ";
+        file << "\n";
+    }
+    for (int from = 0; from < setups.numFamilies(); ++from)
+    {
+        for (int to = 0; to < setups.numFamilies(); ++to) file << setups.entry(from, to) << " ";
+        file << "\n";
+    }
+    return path.string();
+}
+
+#endif // TEST_SUPPORT_H